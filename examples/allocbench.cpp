@@ -0,0 +1,125 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Count the heap allocations made by steady-state frames. The same
+// sequence of frames (docks, the demo window, the mouse sweeping the
+// screen) is run twice: the first pass creates the windows
+// and grows the buffers, the second one should not allocate. Allocations
+// are counted in ImGuiIO::MemAllocFn and in the global operator new.
+// Pass "deindex" to call ImDrawData::DeIndexAllBuffers() after each
+// frame, like renderers without indexed drawing do.
+// Usage: allocbench [nframes] [deindex]
+// Returns 1 if the second pass allocated.
+
+#include <imgui.h>
+#include <imgui_impl_soft.h>
+#include <imgui_dock.h>
+#include <imgui_widgets.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+using namespace std;
+using namespace ImGui;
+
+static bool counting = false;
+static long nalloc = 0, nnew = 0;
+static size_t nbytes = 0;
+
+static void *counting_malloc(size_t size){
+  if (counting){
+    nalloc++;
+    nbytes += size;
+  }
+  return malloc(size);
+}
+
+void *operator new(size_t size){
+  if (counting)
+    nnew++;
+  void *ptr = malloc(size);
+  if (!ptr) throw bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+static void frame(int n, bool deindex){
+  ImGuiIO& io = GetIO();
+  io.MousePos = ImVec2((float) ((n * 37) % 1280), (float) ((n * 53) % 720));
+  ImGui_ImplSoft_NewFrame(1.f/60.f);
+
+  static bool pcont = true;
+  SetNextWindowPos(ImVec2(270,20),ImGuiSetCond_FirstUseEver);
+  SetNextWindowSize(ImVec2(300,300),ImGuiSetCond_FirstUseEver);
+  Dock *dcont = Container("One Container",&pcont);
+  for (int i=0;i<3;i++){
+    char tmp[16];
+    sprintf(tmp,"Dck #%d",i);
+    if (BeginDock(tmp,nullptr,0,0,dcont)){
+      Text("Hello, world!");
+      Button("Click me!");
+    }
+    EndDock();
+  }
+  for (int i=0;i<5;i++){
+    SetNextWindowPos(ImVec2(20.f+10*i,40.f+10*i),ImGuiSetCond_FirstUseEver);
+    SetNextWindowSize(ImVec2(200.f,200.f),ImGuiSetCond_FirstUseEver);
+    char tmp[16];
+    sprintf(tmp,"Dock #%d",i);
+    if (BeginDock(tmp,nullptr)){
+      Text("Hello, world!");
+      if (Button("Click me!") || IsItemHovered())
+        SetTooltip("Dock %d",i);
+    }
+    EndDock();
+  }
+  SetNextWindowPos(ImVec2(20,400),ImGuiSetCond_FirstUseEver);
+  ShowTestWindow();
+  ShowMetricsWindow();
+
+  Render();
+  if (deindex)
+    GetDrawData()->DeIndexAllBuffers();
+}
+
+int main(int argc, char *argv[]){
+  int nframes = (argc > 1) ? atoi(argv[1]) : 1000;
+  bool deindex = (argc > 2) && !strcmp(argv[2],"deindex");
+
+  GetIO().MemAllocFn = counting_malloc;
+  ImGui_ImplSoft_Init(1280, 720, 1);
+  GetIO().IniFilename = nullptr;
+
+  for (int n = 0; n < nframes; n++)
+    frame(n,deindex);
+
+  counting = true;
+  for (int n = 0; n < nframes; n++)
+    frame(n,deindex);
+  counting = false;
+
+  printf("%d frames: %ld MemAlloc calls (%lu bytes), %ld operator new calls\n",
+         nframes, nalloc, (unsigned long) nbytes, nnew);
+
+  ShutdownDock();
+  ImGui_ImplSoft_Shutdown();
+  return (nalloc > 0 || nnew > 0) ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Time the tessellation of polylines and convex fills by ImDrawList:
+// anti-aliased thin, thick and closed polylines, non anti-aliased
+// polylines, and anti-aliased convex fills of 64 and 600 points. Each
+// primitive is added to a cleared draw list many times and the best
+// time per call is printed, with a hash of the vertex and index
+// buffers so that builds with and without IMGUI_DISABLE_SSE can be
+// checked to give the same output. The timings are only meaningful
+// when the library and the benchmark are built with -O2.
+// Usage: drawbench [reps]
+
+#include <imgui.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+using namespace std;
+using namespace ImGui;
+
+static const int npoints = 600;
+static const int calls = 20;
+
+static unsigned long long hash_drawlist(const ImDrawList &dl){
+  unsigned long long h = 1469598103934665603ULL;
+  const unsigned char *p = (const unsigned char *) dl.VtxBuffer.Data;
+  for (size_t i = 0; i < dl.VtxBuffer.Size * sizeof(ImDrawVert); i++)
+    h = (h ^ p[i]) * 1099511628211ULL;
+  p = (const unsigned char *) dl.IdxBuffer.Data;
+  for (size_t i = 0; i < dl.IdxBuffer.Size * sizeof(ImDrawIdx); i++)
+    h = (h ^ p[i]) * 1099511628211ULL;
+  return h;
+}
+
+int main(int argc, char *argv[]){
+  int reps = (argc > 1) ? atoi(argv[1]) : 200;
+
+  ImGuiIO& io = GetIO();
+  io.DisplaySize = ImVec2(1280,720);
+  io.IniFilename = nullptr;
+  unsigned char *pixels;
+  int width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);
+  NewFrame();
+
+  // a wobbly curve, with one degenerate segment, and a circle
+  static ImVec2 curve[npoints], circle[64];
+  for (int i = 0; i < npoints; i++){
+    float t = i * 0.05f;
+    curve[i] = ImVec2(400 + 300 * cosf(t) * (1 + 0.1f * sinf(7 * t)), 300 + 200 * sinf(t * 1.3f));
+  }
+  curve[5] = curve[4];
+  for (int i = 0; i < 64; i++)
+    circle[i] = ImVec2(100 + 50 * cosf(i * 6.2831853f / 64), 100 + 50 * sinf(i * 6.2831853f / 64));
+
+  const char *names[] = {"polyline AA thin","polyline AA thin closed","polyline AA thick",
+                         "polyline non-AA","convex fill AA 64","convex fill AA 600"};
+  ImDrawList dl;
+  for (int c = 0; c < IM_ARRAYSIZE(names); c++){
+    double best = 1e30;
+    for (int r = 0; r < reps; r++){
+      dl.Clear();
+      dl.PushTextureID(io.Fonts->TexID);
+      dl.PushClipRectFullScreen();
+      auto t0 = chrono::steady_clock::now();
+      for (int k = 0; k < calls; k++){
+        switch (c){
+        case 0: dl.AddPolyline(curve,npoints,0xFF00FFFF,false,1.0f,true); break;
+        case 1: dl.AddPolyline(curve,npoints,0xFF00FFFF,true,1.0f,true); break;
+        case 2: dl.AddPolyline(curve,npoints,0xFF00FFFF,false,3.0f,true); break;
+        case 3: dl.AddPolyline(curve,npoints,0xFF00FFFF,false,2.0f,false); break;
+        case 4: dl.AddConvexPolyFilled(circle,64,0xFF00FF00,true); break;
+        case 5: dl.AddConvexPolyFilled(curve,npoints,0xFF00FF00,true); break;
+        }
+      }
+      double t = chrono::duration<double,micro>(chrono::steady_clock::now() - t0).count() / calls;
+      if (t < best) best = t;
+    }
+    printf("%-24s %8.2f us/call  hash %016llx\n",names[c],best,hash_drawlist(dl));
+  }
+
+  Render();
+  Shutdown();
+  return 0;
+}
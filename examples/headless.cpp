@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Render a few frames with docks and containers using the software
+// rasterizer, without a window or GL context. Writes the last frame
+// to headless.ppm and prints the average render time.
+// Usage: headless [nframes] [nthreads]
+
+#include <imgui.h>
+#include <imgui_impl_soft.h>
+#include <imgui_dock.h>
+#include <imgui_widgets.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+using namespace ImGui;
+
+int main(int argc, char *argv[]){
+  int nframes = (argc > 1) ? atoi(argv[1]) : 100;
+  int nthreads = (argc > 2) ? atoi(argv[2]) : 0;
+
+  // Setup ImGui binding
+  ImGui_ImplSoft_Init(1280, 720, nthreads);
+  ImGui_ImplSoft_SetClearColor(IM_COL32(114,144,154,255));
+
+  // GUI settings
+  ImGuiIO& io = GetIO();
+  io.IniFilename = nullptr;
+
+  // Main loop
+  double time = 0.;
+  for (int n = 0; n < nframes; n++){
+    ImGui_ImplSoft_NewFrame(1.f/60.f);
+
+    // A root container and a container with docks attached
+    static bool proot = true;
+    SetNextWindowPos(ImVec2(590,70),ImGuiSetCond_FirstUseEver);
+    SetNextWindowSize(ImVec2(400,400),ImGuiSetCond_FirstUseEver);
+    RootContainer("Root Container",&proot);
+
+    static bool pcont = true;
+    SetNextWindowPos(ImVec2(270,20),ImGuiSetCond_FirstUseEver);
+    SetNextWindowSize(ImVec2(300,300),ImGuiSetCond_FirstUseEver);
+    Dock *dcont = Container("One Container",&pcont);
+    for (int i=0;i<3;i++){
+      char tmp[16];
+      sprintf(tmp,"Dck #%d",i);
+      if (BeginDock(tmp,nullptr,0,0,dcont)){
+        Text("Hello, world!");
+        Button("Click me!");
+      }
+      EndDock();
+    }
+
+    // Some docks unattached on the side
+    for (int i=0;i<5;i++){
+      SetNextWindowPos(ImVec2(20.f+10*i,40.f+10*i),ImGuiSetCond_FirstUseEver);
+      SetNextWindowSize(ImVec2(200.f,200.f),ImGuiSetCond_FirstUseEver);
+      char tmp[16];
+      sprintf(tmp,"Dock #%d",i);
+      if (BeginDock(tmp,nullptr)){
+        Text("Hello, world!");
+        Button("Click me!");
+      }
+      EndDock();
+    }
+
+    // The demo window, for some text and widgets
+    SetNextWindowPos(ImVec2(20,400),ImGuiSetCond_FirstUseEver);
+    ShowTestWindow();
+
+    Render();
+    time += ImGui_ImplSoft_GetRenderTime();
+  }
+  printf("%d frames, %.3f ms/frame (render only)\n", nframes, nframes > 0 ? time / nframes : 0.);
+  if (!ImGui_ImplSoft_SaveScreenshot("headless.ppm"))
+    fprintf(stderr,"Error writing headless.ppm\n");
+
+  // Cleanup
+  ShutdownDock();
+  ImGui_ImplSoft_Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Worker threads write progress lines as fast as they can while the
+// GUI thread shows them. Two setups are compared: a mutex around an
+// ImGuiTextBuffer that the GUI draws every frame, and a LogRing
+// drained into a LogViewer once per frame. The time spent by the
+// workers, the frame times of the GUI thread and the number of
+// dropped and stalled messages are printed. The frames are built but
+// not rasterized.
+// Usage: logringbench [nthreads] [nlines_per_thread] [block]
+
+#include <imgui.h>
+#include <imgui_logview.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ImGui;
+
+static double now_ms(){
+  return chrono::duration<double,milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void begin_frame(){
+  GetIO().DeltaTime = 1.f/60.f;
+  NewFrame();
+  SetNextWindowPos(ImVec2(0,0));
+  SetNextWindowSize(ImVec2(1280,720));
+  Begin("Log",nullptr,ImGuiWindowFlags_NoTitleBar);
+}
+
+static void end_frame(){
+  End();
+  Render();
+}
+
+// Run the workers and call gui() in frames until they finish
+template<typename Fwork, typename Fgui>
+static void run(const char *name, int nthreads, int nlines, Fwork work, Fgui gui){
+  atomic<int> running(nthreads);
+  atomic<long long> worktime(0);
+  vector<thread> threads;
+  for (int t = 0; t < nthreads; t++)
+    threads.push_back(thread([&,t](){
+      double t0 = now_ms();
+      for (int i = 0; i < nlines; i++)
+        work(t,i);
+      worktime += (long long) (1000. * (now_ms() - t0));
+      running--;
+    }));
+
+  int nframes = 0;
+  double tmax = 0., ttot = 0.;
+  bool done = false;
+  while (!done){
+    done = running.load() == 0;
+    double t0 = now_ms();
+    begin_frame();
+    gui();
+    end_frame();
+    double dt = now_ms() - t0;
+    ttot += dt;
+    if (dt > tmax) tmax = dt;
+    nframes++;
+  }
+  for (auto &th : threads)
+    th.join();
+  printf("%-14s worker: %8.1f ms/thread  gui: %5d frames, %7.3f ms/frame avg, %7.3f ms max\n",
+         name,(double) worktime.load() / 1000. / nthreads,nframes,ttot / nframes,tmax);
+}
+
+int main(int argc, char *argv[]){
+  int nthreads = (argc > 1) ? atoi(argv[1]) : 4;
+  int nlines = (argc > 2) ? atoi(argv[2]) : 200000;
+  bool block = (argc > 3) && !strcmp(argv[3],"block");
+
+  ImGuiIO& io = GetIO();
+  io.DisplaySize = ImVec2(1280,720);
+  io.IniFilename = nullptr;
+  unsigned char *pixels;
+  int width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);
+
+  // mutex and text buffer
+  {
+    mutex mtx;
+    ImGuiTextBuffer buf;
+    run("mutex+buffer",nthreads,nlines,
+        [&](int t, int i){
+          lock_guard<mutex> lock(mtx);
+          buf.appendf("[thread %d] step %d: energy = %.10f\n",t,i,-1234.5 + 1e-7 * i);
+        },
+        [&](){
+          lock_guard<mutex> lock(mtx);
+          BeginChild("##log");
+          TextUnformatted(buf.begin(),buf.end());
+          SetScrollHere(1.0f);
+          EndChild();
+        });
+  }
+
+  // lock-free ring and log viewer
+  {
+    static LogRing<4096> ring;
+    ring.policy = block ? LogRing<4096>::Policy_Block : LogRing<4096>::Policy_Drop;
+    LogViewer lv;
+    run(block ? "ring (block)" : "ring (drop)",nthreads,nlines,
+        [&](int t, int i){
+          ring.Printf("[thread %d] step %d: energy = %.10f",t,i,-1234.5 + 1e-7 * i);
+        },
+        [&](){
+          lv.Drain(ring);
+          lv.Draw("##log",ImVec2(0,0),LogViewer::LogViewerFlags_AutoScroll);
+        });
+    begin_frame();
+    lv.Drain(ring);
+    end_frame();
+    printf("%-14s %d lines shown, %lu dropped, %lu stalled\n","",lv.GetLineCount(),
+           (unsigned long) ring.dropped.load(),(unsigned long) ring.stalled.load());
+  }
+
+  Shutdown();
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Open a large log in a LogViewer and measure the time to open it,
+// the frames until it is fully indexed, the frame time while
+// scrolling, jumping to a line and searching, and the heap memory
+// used. A log of the given size is written first if the file does
+// not exist. Then checks that jumping beyond line 10^7 of a text
+// shows that line at the top.
+// Usage: logviewbench [file] [size_in_MB]
+
+#include <imgui.h>
+#include <imgui_impl_soft.h>
+#include <imgui_logview.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace ImGui;
+
+static size_t heapbytes = 0;
+
+static void *counting_malloc(size_t size){
+  heapbytes += size;
+  return malloc(size);
+}
+
+static double now_ms(){
+  return chrono::duration<double,milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void frame(LogViewer *lv){
+  ImGui_ImplSoft_NewFrame(1.f/60.f);
+  SetNextWindowPos(ImVec2(0,0));
+  SetNextWindowSize(ImVec2(1280,720));
+  Begin("Log",nullptr,ImGuiWindowFlags_NoTitleBar);
+  lv->Draw("##log",ImVec2(0,0),LogViewer::LogViewerFlags_LineNumbers|LogViewer::LogViewerFlags_Toolbar);
+  End();
+  Render();
+}
+
+int main(int argc, char *argv[]){
+  const char *file = (argc > 1) ? argv[1] : "logviewbench.log";
+  size_t mb = (argc > 2) ? (size_t) atoi(argv[2]) : 256;
+
+  FILE *fp = fopen(file,"rb");
+  if (fp)
+    fclose(fp);
+  else {
+    printf("writing %lu MB to %s\n",(unsigned long) mb,file);
+    fp = fopen(file,"wb");
+    if (!fp) return 1;
+    char line[256];
+    for (size_t n = 0, written = 0; written < mb << 20; n++){
+      int len = snprintf(line,sizeof(line),"[%9lu] step %lu: energy = %.10f, gradient = %.6e\n",
+                         (unsigned long) n, (unsigned long) (n % 1000), -1234.5 + 1e-7 * n, 1e-3 / (1 + n));
+      fwrite(line,1,len,fp);
+      written += len;
+    }
+    fclose(fp);
+  }
+
+  GetIO().MemAllocFn = counting_malloc;
+  ImGui_ImplSoft_Init(1280, 720, 1);
+  GetIO().IniFilename = nullptr;
+  LogViewer lv;
+  for (int i = 0; i < 3; i++)
+    frame(&lv); // warm up the context with an empty viewer
+
+  size_t heap0 = heapbytes;
+  double t0 = now_ms();
+  if (!lv.OpenFile(file)){
+    printf("could not open %s\n",file);
+    return 1;
+  }
+  printf("open: %.3f ms, %.1f MB\n",now_ms() - t0,(double) lv.size / (1 << 20));
+
+  int nframes = 0;
+  t0 = now_ms();
+  double tmax = 0.;
+  while (lv.indexed < lv.size){
+    double t1 = now_ms();
+    frame(&lv);
+    double dt = now_ms() - t1;
+    if (dt > tmax) tmax = dt;
+    nframes++;
+  }
+  printf("indexed in %d frames, %.1f ms (slowest frame %.1f ms), %d lines, index %lu bytes\n",
+         nframes,now_ms() - t0,tmax,lv.GetLineCount(),(unsigned long) lv.index.Size * sizeof(ImU64));
+
+  t0 = now_ms();
+  for (int i = 0; i < 100; i++)
+    frame(&lv);
+  printf("steady: %.3f ms/frame\n",(now_ms() - t0) / 100.);
+
+  int nl = lv.GetLineCount();
+  t0 = now_ms();
+  for (int i = 0; i < 100; i++){
+    lv.ScrollToLine((int) ((double) nl * i / 100.));
+    frame(&lv);
+  }
+  printf("jump to 100 lines across the file: %.3f ms/frame\n",(now_ms() - t0) / 100.);
+
+  char needle[64];
+  snprintf(needle,sizeof(needle),"[%9d]",nl - 10);
+  t0 = now_ms();
+  int found = lv.Find(needle,-1);
+  printf("find \"%s\": line %d in %.1f ms\n",needle,found + 1,now_ms() - t0);
+  t0 = now_ms();
+  found = lv.Find("step 999:",found,true);
+  printf("find backwards \"step 999:\": line %d in %.3f ms\n",found + 1,now_ms() - t0);
+
+  printf("heap allocated while viewing: %lu bytes\n",(unsigned long) (heapbytes - heap0));
+  lv.Clear();
+
+  // Jump past line 10^7 of a text of 1.2*10^7 short lines, where a
+  // scroll position in pixels held in a float is off by whole lines,
+  // and scroll from there with the mouse wheel.
+  const int nbig = 12000000;
+  vector<char> buf;
+  for (int n = 0; n < nbig; n++){
+    char line[16];
+    int len = snprintf(line,sizeof(line),"%d\n",n);
+    buf.insert(buf.end(),line,line + len);
+    if (buf.size() > (1 << 20) || n == nbig - 1){
+      lv.Append(buf.data(),buf.data() + buf.size());
+      buf.clear();
+    }
+  }
+  frame(&lv);
+  const int wheel = (int) (5.f * GetFontSize() / GetTextLineHeightWithSpacing() + 0.5f);
+  bool ok = lv.GetLineCount() == nbig;
+  const int targets[] = {10000000, 10500017, 11000003};
+  for (int k = 0; k < 3 && ok; k++){
+    lv.ScrollToLine(targets[k]);
+    frame(&lv);
+    frame(&lv);
+    ok = ok && lv.topline == targets[k];
+    GetIO().MousePos = ImVec2(640,360);
+    GetIO().MouseWheel = -1.f;
+    frame(&lv);
+    GetIO().MouseWheel = 0.f;
+    frame(&lv);
+    const char *b, *e;
+    ok = ok && lv.topline == targets[k] + wheel && lv.GetLine(lv.topline,&b,&e) && atoi(b) == targets[k] + wheel;
+  }
+  printf("jump beyond line 10000000 and scroll with the wheel: %s\n",ok ? "ok" : "WRONG");
+
+  lv.Clear();
+  ImGui_ImplSoft_Shutdown();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A long trace (a random walk with a few isolated spikes) plotted
+// with PlotLines from an array and from an ImGuiPlotMinMax. Prints
+// the time to build and append to the pyramid, the frame times of
+// both plots, whether the spikes are drawn, and checks the range
+// queries of the pyramid against a direct scan. The frames are built
+// but not rasterized. The Makefile builds without optimization; the
+// times drop by 2-3x when the library and the benchmark use -O2.
+// Usage: plotbench [nvalues]
+
+#include <imgui.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace ImGui;
+
+static double now_ms(){
+  return chrono::duration<double,milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template<typename F>
+static double frames(int n, F gui){
+  double t0 = now_ms();
+  for (int i = 0; i < n; i++){
+    GetIO().DeltaTime = 1.f/60.f;
+    NewFrame();
+    SetNextWindowPos(ImVec2(0,0));
+    SetNextWindowSize(ImVec2(1280,720));
+    Begin("Trace",nullptr,ImGuiWindowFlags_NoTitleBar);
+    gui();
+    End();
+    Render();
+  }
+  return (now_ms() - t0) / n;
+}
+
+// Number of separate places where the last plot reaches its top
+static int spikes_drawn(){
+  const float top = GetItemRectMin().y + GetStyle().FramePadding.y;
+  ImDrawList *dl = GetWindowDrawList();
+  vector<float> xs;
+  for (int i = 0; i < dl->VtxBuffer.Size; i++)
+    if (fabsf(dl->VtxBuffer[i].pos.y - top) < 1.f)
+      xs.push_back(dl->VtxBuffer[i].pos.x);
+  sort(xs.begin(),xs.end());
+  int n = 0;
+  for (size_t i = 0; i < xs.size(); i++)
+    if (i == 0 || xs[i] - xs[i-1] > 3.f)
+      n++;
+  return n;
+}
+
+int main(int argc, char *argv[]){
+  int n = (argc > 1) ? atoi(argv[1]) : 10000000;
+
+  ImGuiIO& io = GetIO();
+  io.DisplaySize = ImVec2(1280,720);
+  io.IniFilename = nullptr;
+  unsigned char *pixels;
+  int width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);
+
+  srand(1);
+  vector<float> v(n);
+  float x = 0.f;
+  for (int i = 0; i < n; i++){
+    x += (float) rand() / RAND_MAX - 0.5f;
+    v[i] = x;
+  }
+  const int nspikes = 5;
+  for (int k = 0; k < nspikes; k++)
+    v[(size_t) n * (2 * k + 1) / (2 * nspikes) + 7] = 1e4f;
+
+  ImGuiPlotMinMax trace;
+  const int tail = n / 100;
+  double t0 = now_ms();
+  trace.Build(v.data(),n - tail);
+  printf("build %d values: %.1f ms, %d levels, pyramid %.1f MB\n",n - tail,now_ms() - t0,
+         trace.LevelsCount,[&](){ size_t s = 0; for (int k = 0; k < trace.LevelsCount; k++) s += trace.Levels[k].Size; return s * sizeof(ImVec2) / 1048576.;}());
+  t0 = now_ms();
+  for (int i = n - tail; i < n; i += 100)
+    trace.Append(v.data() + i,i + 100 < n ? 100 : n - i);
+  printf("append %d values, 100 at a time: %.1f ms\n",tail,now_ms() - t0);
+
+  const ImVec2 size(1200,300);
+  int spikes_array = 0, spikes_minmax = 0;
+  printf("PlotLines (array, fixed scale): %.3f ms/frame\n",frames(20,[&](){
+        PlotLines("##array",v.data(),n,0,nullptr,-1e4f,1e4f,size);
+        spikes_array = spikes_drawn();
+      }));
+  printf("PlotLines (array, auto scale): %.3f ms/frame\n",frames(20,[&](){
+        PlotLines("##array",v.data(),n,0,nullptr,FLT_MAX,FLT_MAX,size);
+      }));
+  printf("PlotLines (min/max pyramid): %.3f ms/frame\n",frames(100,[&](){
+        PlotLines("##minmax",trace,nullptr,-1e4f,1e4f,size);
+        spikes_minmax = spikes_drawn();
+      }));
+  printf("spikes drawn: array %d of %d, pyramid %d of %d\n",spikes_array,nspikes,spikes_minmax,nspikes);
+
+  // exact range queries
+  bool ok = trace.Size() == n;
+  for (int q = 0; ok && q < 2000; q++){
+    int a = rand() % n, b = a + rand() % ((q & 1) ? 100 : n - a + 1);
+    if (b > n) b = n;
+    if (a == b) continue;
+    float vmin = v[a], vmax = v[a];
+    for (int i = a; i < b; i++){
+      vmin = v[i] < vmin ? v[i] : vmin;
+      vmax = v[i] > vmax ? v[i] : vmax;
+    }
+    ImVec2 mm = trace.GetMinMax(a,b);
+    ok = mm.x == vmin && mm.y == vmax;
+  }
+  printf("range queries %s\n",ok ? "ok" : "WRONG");
+
+  Shutdown();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compare the sorted-vector and the hash-table ImGuiStorage: time to
+// insert N random keys and to look them all up, for N from 10^3 to
+// 10^6. Keys are ImHash() of integers, like the IDs of tree nodes.
+// Sorted insertion is O(N) per key: above 10^5 keys, the sorted storage
+// is filled in bulk (push_back + BuildSortByKey) and only lookups are
+// timed.
+// Usage: storagebench [maxkeys]
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace ImGui;
+
+static double elapsed_ms(chrono::high_resolution_clock::time_point t0){
+  return chrono::duration<double,milli>(chrono::high_resolution_clock::now() - t0).count();
+}
+
+static const size_t maxsortedinsert = 100000;
+
+static void bench(const vector<ImGuiID> &keys, bool usehash, double *tinsert, double *tlookup){
+  ImGuiStorage storage;
+  storage.SetUseHashTable(usehash);
+
+  auto t0 = chrono::high_resolution_clock::now();
+  if (usehash || keys.size() <= maxsortedinsert){
+    for (size_t i = 0; i < keys.size(); i++)
+      storage.SetInt(keys[i], (int) i);
+    *tinsert = elapsed_ms(t0);
+  } else {
+    for (size_t i = 0; i < keys.size(); i++)
+      storage.Data.push_back(ImGuiStorage::Pair(keys[i], (int) i));
+    storage.BuildSortByKey();
+    *tinsert = -1.;
+  }
+
+  long sum = 0;
+  t0 = chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < keys.size(); i++)
+    sum += storage.GetInt(keys[i], -1);
+  *tlookup = elapsed_ms(t0);
+
+  long expected = (long) keys.size() * ((long) keys.size() - 1) / 2;
+  if (sum != expected)
+    printf("error: wrong lookup result (%ld != %ld)\n", sum, expected);
+}
+
+int main(int argc, char *argv[]){
+  int maxkeys = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+  printf("%10s | %14s %14s | %14s %14s\n","keys","sorted ins(ms)","sorted get(ms)","hash ins(ms)","hash get(ms)");
+  for (int n = 1000; n <= maxkeys; n *= 10){
+    vector<ImGuiID> keys(n);
+    for (int i = 0; i < n; i++)
+      keys[i] = ImHash(&i, sizeof(i), 0);
+
+    double tis, tls, tih, tlh;
+    bench(keys,false,&tis,&tls);
+    bench(keys,true,&tih,&tlh);
+    if (tis >= 0.)
+      printf("%10d | %14.3f %14.3f | %14.3f %14.3f\n",n,tis,tls,tih,tlh);
+    else
+      printf("%10d | %14s %14.3f | %14.3f %14.3f\n",n,"-",tls,tih,tlh);
+  }
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A list of atoms (element and coordinates) shown in a Table and,
+// for comparison, with Columns and a list clipper. Prints the frame
+// times of both, and the time to sort, reverse, filter, append rows
+// and change rows of the Table. The frames are built but not
+// rasterized.
+// Usage: tablebench [nrows]
+
+#include <imgui.h>
+#include <imgui_table.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace ImGui;
+
+struct Atom{
+  int z;
+  double x[3];
+};
+
+static const char *symbols[] = {"H","He","Li","Be","B","C","N","O","F","Ne"};
+
+static vector<Atom> atoms;
+
+static double now_ms(){
+  return chrono::duration<double,milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static Atom random_atom(){
+  Atom a;
+  a.z = rand() % 10;
+  for (int j = 0; j < 3; j++)
+    a.x[j] = 100. * rand() / RAND_MAX;
+  return a;
+}
+
+static const char *getter(void *data, int row, int col, char *buf, int size){
+  const Atom &a = (*(vector<Atom> *) data)[row];
+  switch (col){
+  case 0: snprintf(buf,size,"%d",row+1); return buf;
+  case 1: return symbols[a.z];
+  default: snprintf(buf,size,"%.6f",a.x[col-2]); return buf;
+  }
+}
+
+static double key(void *data, int row, int col){
+  const Atom &a = (*(vector<Atom> *) data)[row];
+  switch (col){
+  case 0: return row;
+  case 1: return a.z;
+  default: return a.x[col-2];
+  }
+}
+
+template<typename F>
+static double frames(int n, F gui){
+  double t0 = now_ms();
+  for (int i = 0; i < n; i++){
+    GetIO().DeltaTime = 1.f/60.f;
+    NewFrame();
+    SetNextWindowPos(ImVec2(0,0));
+    SetNextWindowSize(ImVec2(1280,720));
+    Begin("Atoms",nullptr,ImGuiWindowFlags_NoTitleBar);
+    gui(i);
+    End();
+    Render();
+  }
+  return (now_ms() - t0) / n;
+}
+
+int main(int argc, char *argv[]){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+  ImGuiIO& io = GetIO();
+  io.DisplaySize = ImVec2(1280,720);
+  io.IniFilename = nullptr;
+  unsigned char *pixels;
+  int width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);
+
+  srand(1);
+  atoms.reserve(n + 1000);
+  for (int i = 0; i < n; i++)
+    atoms.push_back(random_atom());
+
+  // Columns and list clipper
+  double t = frames(100,[](int){
+      BeginChild("##columns");
+      Columns(5,"atoms");
+      ImGuiListClipper clipper((int) atoms.size(),GetTextLineHeightWithSpacing());
+      while (clipper.Step()){
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++){
+          const Atom &a = atoms[i];
+          Text("%d",i+1); NextColumn();
+          Text("%s",symbols[a.z]); NextColumn();
+          for (int j = 0; j < 3; j++){
+            Text("%.6f",a.x[j]);
+            NextColumn();
+          }
+        }
+      }
+      Columns(1);
+      EndChild();
+    });
+  printf("columns+clipper: %.3f ms/frame\n",t);
+
+  // Table
+  Table table;
+  table.AddColumn("#",Table::TableColumnFlags_Numeric);
+  table.AddColumn("Element");
+  table.AddColumn("x",Table::TableColumnFlags_Numeric);
+  table.AddColumn("y",Table::TableColumnFlags_Numeric);
+  table.AddColumn("z",Table::TableColumnFlags_Numeric);
+  double t0 = now_ms();
+  table.SetData(getter,key,&atoms,n);
+  printf("table: set data %.1f ms\n",now_ms() - t0);
+  auto draw = [&](int){ table.Draw("##table",ImVec2(0,0),Table::TableFlags_Filter|Table::TableFlags_RowBg);};
+  printf("table: %.3f ms/frame\n",frames(100,draw));
+  printf("table: %.3f ms/frame while scrolling\n",frames(100,[&](int i){
+        table.ScrollToRow((int) ((double) n * i / 100.));
+        draw(i);
+      }));
+
+  t0 = now_ms();
+  table.SortBy(2);
+  printf("sort by x: %.1f ms\n",now_ms() - t0);
+  t0 = now_ms();
+  table.SortBy(2,true);
+  printf("reverse: %.1f ms\n",now_ms() - t0);
+
+  const char *filters[] = {"1","12","12.","12.3"};
+  for (const char *f : filters){
+    t0 = now_ms();
+    table.SetFilter(f);
+    printf("filter \"%s\": %d rows in %.1f ms\n",f,table.GetRowCount(),now_ms() - t0);
+  }
+  table.SetFilter("");
+
+  t0 = now_ms();
+  for (int i = 0; i < 1000; i++)
+    atoms.push_back(random_atom());
+  table.SetRowCount((int) atoms.size());
+  printf("append 1000 rows: %.1f ms\n",now_ms() - t0);
+
+  t0 = now_ms();
+  for (int i = 0; i < 100; i++)
+    atoms[n/2 + i] = random_atom();
+  table.UpdateRows(n/2,100);
+  printf("change 100 rows: %.1f ms\n",now_ms() - t0);
+
+  // check the order
+  bool ok = table.GetRowCount() == (int) atoms.size();
+  for (int i = 1; ok && i < table.GetRowCount(); i++)
+    ok = atoms[table.GetRow(i-1)].x[0] >= atoms[table.GetRow(i)].x[0];
+  printf("order %s\n",ok ? "ok" : "WRONG");
+
+  Shutdown();
+  return ok ? 0 : 1;
+}
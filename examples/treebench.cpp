@@ -0,0 +1,148 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>.
+
+  imgui-goodies is free software: you can redistribute it and/or
+  modify it under the terms of the GNU General Public License as
+  published by the Free Software Foundation, either version 3 of the
+  License, or (at your option) any later version.
+
+  imgui-goodies is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A complete tree with four children per node, fully open, drawn with
+// TreeNode calls and with a Tree. Prints the frame times of both, and
+// the time to open and close nodes of the Tree, and checks its index
+// of the rows of the nodes. The frames are built but not rasterized.
+// Usage: treebench [nnodes]
+
+#include <imgui.h>
+#include <imgui_tree.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+using namespace std;
+using namespace ImGui;
+
+static const int nchild = 4;
+static int nnodes;
+
+static double now_ms(){
+  return chrono::duration<double,milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// children of node i are nchild*i+1 to nchild*i+nchild; node 0 is the root
+static int childcount(void *, int node){
+  if (node < 0) return 1;
+  int first = nchild * node + 1;
+  if (first >= nnodes) return 0;
+  return nnodes - first < nchild ? nnodes - first : nchild;
+}
+
+static int child(void *, int node, int k){
+  return node < 0 ? 0 : nchild * node + 1 + k;
+}
+
+static const char *label(void *, int node, char *buf, int size){
+  snprintf(buf,size,"Critical point %d",node);
+  return buf;
+}
+
+static void treenode(int node){
+  char buf[64];
+  label(nullptr,node,buf,sizeof(buf));
+  int n = childcount(nullptr,node);
+  if (n == 0){
+    TreeNodeEx((void *) (intptr_t) node,ImGuiTreeNodeFlags_Leaf|ImGuiTreeNodeFlags_NoTreePushOnOpen,"%s",buf);
+  } else if (TreeNodeEx((void *) (intptr_t) node,ImGuiTreeNodeFlags_DefaultOpen,"%s",buf)){
+    for (int k = 0; k < n; k++)
+      treenode(child(nullptr,node,k));
+    TreePop();
+  }
+}
+
+template<typename F>
+static double frames(int n, F gui){
+  double t0 = now_ms();
+  for (int i = 0; i < n; i++){
+    GetIO().DeltaTime = 1.f/60.f;
+    NewFrame();
+    SetNextWindowPos(ImVec2(0,0));
+    SetNextWindowSize(ImVec2(1280,720));
+    Begin("Graph",nullptr,ImGuiWindowFlags_NoTitleBar);
+    gui(i);
+    End();
+    Render();
+  }
+  return (now_ms() - t0) / n;
+}
+
+int main(int argc, char *argv[]){
+  nnodes = (argc > 1) ? atoi(argv[1]) : 200000;
+
+  ImGuiIO& io = GetIO();
+  io.DisplaySize = ImVec2(1280,720);
+  io.IniFilename = nullptr;
+  unsigned char *pixels;
+  int width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);
+
+  printf("TreeNode: %.3f ms/frame\n",frames(10,[](int){
+        BeginChild("##treenode");
+        treenode(0);
+        EndChild();
+      }));
+
+  Tree tree;
+  tree.SetData(childcount,child,label,nullptr,nnodes);
+  double t0 = now_ms();
+  tree.SetAllOpen(true);
+  printf("Tree: open all %.1f ms, %d visible rows\n",now_ms() - t0,tree.GetVisibleCount());
+  printf("Tree: %.3f ms/frame\n",frames(100,[&](int){ tree.Draw("##tree");}));
+  printf("Tree: %.3f ms/frame while scrolling\n",frames(100,[&](int i){
+        tree.ScrollToNode((int) ((double) nnodes * i / 100.));
+        tree.Draw("##tree");
+      }));
+
+  t0 = now_ms();
+  for (int i = 1; i <= 100; i++)
+    tree.SetOpen(i,false);
+  printf("close 100 nodes: %.3f ms\n",now_ms() - t0);
+  t0 = now_ms();
+  for (int i = 1; i <= 100; i++)
+    tree.SetOpen(i,true);
+  printf("open 100 nodes: %.3f ms\n",now_ms() - t0);
+  bool ok = tree.GetVisibleCount() == nnodes;
+  t0 = now_ms();
+  tree.SetOpen(0,false);
+  ok = ok && tree.GetVisibleCount() == 1;
+  tree.SetOpen(0,true);
+  printf("close and open the root: %.3f ms\n",now_ms() - t0);
+  ok = ok && tree.GetVisibleCount() == nnodes;
+  printf("visible rows %s\n",ok ? "ok" : "WRONG");
+
+  // the last nodes with children are at the end of the visible rows
+  int last = (nnodes - 2) / nchild;
+  t0 = now_ms();
+  for (int i = last; i > last - 100 && i > 0; i--){
+    tree.SetOpen(i,false);
+    tree.SetOpen(i,true);
+  }
+  printf("close and open 100 nodes at the end: %.3f ms\n",now_ms() - t0);
+  bool okrow = tree.GetVisibleCount() == nnodes;
+  for (int i = 0; i < tree.GetVisibleCount() && okrow; i++)
+    okrow = tree.find(tree.visible[i].node) == i;
+  printf("row index %s\n",okrow ? "ok" : "WRONG");
+  ok = ok && okrow;
+
+  Shutdown();
+  return ok ? 0 : 1;
+}
@@ -30,6 +30,22 @@
 //---- Pack colors to BGRA instead of RGBA (remove need to post process vertex buffer in back ends)
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
+//---- Rasterize glyphs on the calling thread only in ImFontAtlas::Build() (for platforms without std::thread)
+//#define IMGUI_DISABLE_FONT_BUILD_THREADS
+
+//---- Write the .ini file on the calling thread instead of a background thread (for platforms without std::thread)
+//#define IMGUI_DISABLE_INI_SAVE_THREAD
+
+//---- Use the open-addressing hash table in every ImGuiStorage by default (O(1) insertions instead of a sorted vector, no ordering)
+//#define IMGUI_STORAGE_USE_HASH_TABLE
+
+//---- Hash IDs with CRC32C instead of CRC32, using the crc32 instruction of SSE 4.2 when the CPU has it (checked at runtime)
+//---- This changes every ID: windows and docks saved in .ini files by a build without it will not be found
+//#define IMGUI_USE_CRC32C
+
+//---- Don't keep allocation statistics by subsystem (ImGuiMemTag): MemAlloc()/MemFree() no longer look up a table of live allocations
+//#define IMGUI_DISABLE_MEM_TAGS
+
 //---- Implement STB libraries in a namespace to avoid conflicts
 //#define IMGUI_STB_NAMESPACE     ImGuiStb
 
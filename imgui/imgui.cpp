@@ -592,6 +592,13 @@
 #include <stdlib.h>     // NULL, malloc, free, qsort, atoi
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <limits.h>     // INT_MIN, INT_MAX
+#include <string.h>     // strlen, memchr, memcpy
+#include <atomic>       // std::atomic_flag
+#ifndef IMGUI_DISABLE_INI_SAVE_THREAD
+#include <thread>       // std::thread
+#include <mutex>        // std::mutex
+#include <condition_variable>
+#endif
 #if defined(_MSC_VER) && _MSC_VER <= 1500 // MSVC 2008 or earlier
 #include <stddef.h>     // intptr_t
 #else
@@ -648,17 +655,21 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 
 static void             AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDrawList* draw_list);
 static void             AddWindowToRenderList(ImVector<ImDrawList*>& out_render_list, ImGuiWindow* window);
+static void             MergeDrawCommands(ImDrawData* draw_data);
 static void             AddWindowToSortedBuffer(ImVector<ImGuiWindow*>& out_sorted_windows, ImGuiWindow* window);
+static bool             TrimWindowDrawList(ImGuiWindow* window);
 
 static ImGuiWindowSettings* AddWindowSettings(const char* name);
 
 static void             LoadIniSettingsFromDisk(const char* ini_filename);
 static void             LoadIniSettingsFromMemory(const char* buf);
-static void             SaveIniSettingsToDisk(const char* ini_filename);
+static void             SaveIniSettingsToDisk(const char* ini_filename, bool background = false);
+static void             ShutdownSettingsWriter();
 static void             SaveIniSettingsToMemory(ImVector<char>& out_buf);
 static void             MarkIniSettingsDirty(ImGuiWindow* window);
 
 static ImRect           GetVisibleRect();
+static bool             ImFileWriteAtomic(const char* filename, const char* tmp_filename, const char* data, size_t data_size);
 
 static void             CloseInactivePopups(ImGuiWindow* ref_window);
 static void             ClosePopupToLevel(int remaining);
@@ -801,6 +812,9 @@ ImGuiIO::ImGuiIO()
     OptMacOSXBehaviors = false;
 #endif
     OptCursorBlink = true;
+    TextSizeCacheCapacity = 4096;
+    OptMergeDrawCommands = false;
+    DrawListShrinkFrames = 600;
                                 
     // Settings (User Functions)
     RenderDrawListsFn = NULL;
@@ -1020,48 +1034,190 @@ int ImFormatStringV(char* buf, int buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_FORMAT_STRING_FUNCTIONS
 
-// Pass data_size==0 for zero-terminated strings
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImU32 ImHash(const void* data, int data_size, ImU32 seed)
+// ImHash() is a CRC32 (polynomial 0xEDB88320, the same as zlib) so that the IDs stored in .ini files stay valid across builds and versions.
+// With IMGUI_USE_CRC32C it is a CRC32C (Castagnoli) instead, which x86 CPUs with SSE 4.2 compute with the crc32 instruction (checked at runtime).
+// ARMv8 CPUs have instructions for both, used when the compiler targets them (__ARM_FEATURE_CRC32, e.g. -march=armv8-a+crc).
+// Otherwise the software path processes 8 bytes per step with 8 tables ("slice-by-8").
+#ifdef IMGUI_USE_CRC32C
+#define IM_CRC32_POLYNOMIAL 0x82F63B78
+#else
+#define IM_CRC32_POLYNOMIAL 0xEDB88320
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define IMGUI_HASH_CRC32_ARM
+#elif defined(IMGUI_USE_CRC32C) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define IMGUI_HASH_CRC32_SSE42
+#include <nmmintrin.h>  // _mm_crc32_u8, _mm_crc32_u32, _mm_crc32_u64
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // __cpuid
+#define IM_TARGET_SSE42
+#else
+#include <cpuid.h>      // __get_cpuid
+#define IM_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+#endif
+
+struct ImHashCrc32Tables
 {
-    static ImU32 crc32_lut[256] = { 0 };
-    if (!crc32_lut[1])
+    ImU32   Lut[8][256];        // Lut[0] is the usual byte-at-a-time table, Lut[n] advances the CRC of a byte followed by n zero bytes
+    bool    UseHardware;
+
+    ImHashCrc32Tables()
     {
-        const ImU32 polynomial = 0xEDB88320;
         for (ImU32 i = 0; i < 256; i++)
         {
             ImU32 crc = i;
             for (ImU32 j = 0; j < 8; j++)
-                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & polynomial);
-            crc32_lut[i] = crc;
+                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & IM_CRC32_POLYNOMIAL);
+            Lut[0][i] = crc;
         }
+        for (int n = 1; n < 8; n++)
+            for (int i = 0; i < 256; i++)
+                Lut[n][i] = (Lut[n-1][i] >> 8) ^ Lut[0][Lut[n-1][i] & 0xFF];
+
+        UseHardware = false;
+#if defined(IMGUI_HASH_CRC32_SSE42) && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        UseHardware = (info[2] & (1 << 20)) != 0;
+#elif defined(IMGUI_HASH_CRC32_SSE42)
+        unsigned int eax, ebx, ecx, edx;
+        UseHardware = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+#endif
     }
+};
 
-    seed = ~seed;
-    ImU32 crc = seed;
-    const unsigned char* current = (const unsigned char*)data;
+static ImU32 ImHashCrc32Software(const ImHashCrc32Tables& tables, ImU32 crc, const unsigned char* p, size_t size)
+{
+    for (; size >= 8; size -= 8, p += 8)
+    {
+        // Byte loads are endian-independent; compilers merge them into a single load on little-endian targets
+        ImU32 lo = crc ^ ((ImU32)p[0] | ((ImU32)p[1] << 8) | ((ImU32)p[2] << 16) | ((ImU32)p[3] << 24));
+        ImU32 hi = (ImU32)p[4] | ((ImU32)p[5] << 8) | ((ImU32)p[6] << 16) | ((ImU32)p[7] << 24);
+        crc = tables.Lut[7][lo & 0xFF] ^ tables.Lut[6][(lo >> 8) & 0xFF] ^ tables.Lut[5][(lo >> 16) & 0xFF] ^ tables.Lut[4][lo >> 24] ^
+              tables.Lut[3][hi & 0xFF] ^ tables.Lut[2][(hi >> 8) & 0xFF] ^ tables.Lut[1][(hi >> 16) & 0xFF] ^ tables.Lut[0][hi >> 24];
+    }
+    while (size--)
+        crc = (crc >> 8) ^ tables.Lut[0][(crc & 0xFF) ^ *p++];
+    return crc;
+}
 
+#if defined(IMGUI_HASH_CRC32_ARM)
+static ImU32 ImHashCrc32Hardware(ImU32 crc, const unsigned char* p, size_t size)
+{
+    for (; size >= 8; size -= 8, p += 8)
+    {
+        uint64_t v;
+        memcpy(&v, p, 8);
+#ifdef IMGUI_USE_CRC32C
+        crc = __crc32cd(crc, v);
+#else
+        crc = __crc32d(crc, v);
+#endif
+    }
+    while (size--)
+#ifdef IMGUI_USE_CRC32C
+        crc = __crc32cb(crc, *p++);
+#else
+        crc = __crc32b(crc, *p++);
+#endif
+    return crc;
+}
+#elif defined(IMGUI_HASH_CRC32_SSE42)
+static IM_TARGET_SSE42 ImU32 ImHashCrc32Hardware(ImU32 crc, const unsigned char* p, size_t size)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned long long crc64 = crc;
+    for (; size >= 8; size -= 8, p += 8)
+    {
+        unsigned long long v;
+        memcpy(&v, p, 8);
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+    crc = (ImU32)crc64;
+#endif
+    for (; size >= 4; size -= 4, p += 4)
+    {
+        unsigned int v;
+        memcpy(&v, p, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
+    while (size--)
+        crc = _mm_crc32_u8(crc, *p++);
+    return crc;
+}
+#endif
+
+static ImU32 ImHashCrc32(ImU32 crc, const unsigned char* p, size_t size)
+{
+#if defined(IMGUI_HASH_CRC32_ARM)
+    return ImHashCrc32Hardware(crc, p, size);
+#else
+    static const ImHashCrc32Tables tables;  // Initialization is thread-safe (C++11)
+#if defined(IMGUI_HASH_CRC32_SSE42)
+    if (tables.UseHardware)
+        return ImHashCrc32Hardware(crc, p, size);
+#endif
+    return ImHashCrc32Software(tables, crc, p, size);
+#endif
+}
+
+// Pass data_size==0 for zero-terminated strings
+ImU32 ImHash(const void* data, int data_size, ImU32 seed)
+{
+    const unsigned char* current = (const unsigned char*)data;
+    size_t size;
     if (data_size > 0)
     {
         // Known size
-        while (data_size--)
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *current++];
+        size = (size_t)data_size;
     }
     else
     {
         // Zero-terminated string
-        while (unsigned char c = *current++)
-        {
-            // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
-            // Because this syntax is rarely used we are optimizing for the common case.
-            // - If we reach ### in the string we discard the hash so far and reset to the seed.
-            // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller.
-            if (c == '#' && current[0] == '#' && current[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
+        // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+        // Each "###" discards the hash so far and restarts from the seed, so only the part from the last "###" onwards is hashed.
+        // memchr() skips to the next '#' quickly: most labels have none or a single "##" suffix.
+        const char* str = (const char*)data;
+        const char* str_end = str + strlen(str);
+        for (const char* p = (const char*)memchr(str, '#', (size_t)(str_end - str)); p != NULL; p = (const char*)memchr(p + 1, '#', (size_t)(str_end - p - 1)))
+            if (p[1] == '#' && p[2] == '#')
+                current = (const unsigned char*)p;
+        size = (size_t)(str_end - (const char*)current);
+    }
+    return ~ImHashCrc32(~seed, current, size);
+}
+
+// MurmurHash64A, 8 bytes at a time: much faster than ImHash() on long data, and wide enough to key caches without keeping the data for comparison.
+ImU64 ImHash64(const void* data, int data_size, ImU64 seed)
+{
+    const ImU64 m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+    ImU64 h = seed ^ ((ImU64)data_size * m);
+    const unsigned char* p = (const unsigned char*)data;
+    for (; data_size >= 8; data_size -= 8, p += 8)
+    {
+        ImU64 k;
+        memcpy(&k, p, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
     }
-    return ~crc;
+    if (data_size > 0)
+    {
+        ImU64 k = 0;
+        memcpy(&k, p, (size_t)data_size);
+        h ^= k;
+        h *= m;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
 }
 
 //-----------------------------------------------------------------------------
@@ -1429,6 +1585,135 @@ static ImVector<ImGuiStorage::Pair>::iterator LowerBound(ImVector<ImGuiStorage::
     return first;
 }
 
+// Hash table mode: open addressing with linear probing in Data, whose size is a power of two. There is no removal (only Clear()), so there
+// are no tombstones. A free slot has key 0, so the pair with key 0 is kept aside in ZeroKeyPair.
+static inline int StorageHashSlot(ImGuiID key, int mask)
+{
+    // IDs are already hashes, but the mix spreads keys that only differ in their high bits
+    key ^= key >> 16;
+    key *= 0x85EBCA6Bu;
+    key ^= key >> 13;
+    return (int)(key & (ImGuiID)mask);
+}
+
+static void StorageHashGrow(ImGuiStorage* storage, int new_size)
+{
+    ImVector<ImGuiStorage::Pair> old_data;
+    old_data.swap(storage->Data);
+    storage->Data.resize(new_size, ImGuiStorage::Pair(0, (void*)NULL));
+    const int mask = new_size - 1;
+    for (int n = 0; n < old_data.Size; n++)
+    {
+        if (old_data[n].key == 0)
+            continue;
+        int i = StorageHashSlot(old_data[n].key, mask);
+        while (storage->Data[i].key != 0)
+            i = (i + 1) & mask;
+        storage->Data[i] = old_data[n];
+    }
+}
+
+// Find the pair of a key, NULL if missing
+static ImGuiStorage::Pair* StorageFindPair(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStorage* s = const_cast<ImGuiStorage*>(storage);
+    if (!storage->UseHashTable)
+    {
+        ImVector<ImGuiStorage::Pair>::iterator it = LowerBound(s->Data, key);
+        return (it == s->Data.end() || it->key != key) ? NULL : it;
+    }
+    if (key == 0)
+        return storage->HashHasZeroKey ? &s->HashZeroKeyPair : NULL;
+    if (storage->Data.Size == 0)
+        return NULL;
+    const int mask = storage->Data.Size - 1;
+    for (int i = StorageHashSlot(key, mask); ; i = (i + 1) & mask)
+    {
+        ImGuiStorage::Pair* pair = &s->Data.Data[i];
+        if (pair->key == key)
+            return pair;
+        if (pair->key == 0)
+            return NULL;
+    }
+}
+
+// Find the pair of a key, insert 'default_pair' if missing
+static ImGuiStorage::Pair* StorageFindOrInsertPair(ImGuiStorage* storage, const ImGuiStorage::Pair& default_pair)
+{
+    const ImGuiID key = default_pair.key;
+    if (!storage->UseHashTable)
+    {
+        ImVector<ImGuiStorage::Pair>::iterator it = LowerBound(storage->Data, key);
+        if (it == storage->Data.end() || it->key != key)
+        {
+            ImGuiMemTagScope mem_tag(ImGuiMemTag_Storage);
+            it = storage->Data.insert(it, default_pair);
+        }
+        return it;
+    }
+    if (key == 0)
+    {
+        if (!storage->HashHasZeroKey)
+        {
+            storage->HashZeroKeyPair = default_pair;
+            storage->HashHasZeroKey = true;
+        }
+        return &storage->HashZeroKeyPair;
+    }
+    if ((storage->HashCount + 1) * 4 > storage->Data.Size * 3) // Keep the load factor under 3/4
+    {
+        ImGuiMemTagScope mem_tag(ImGuiMemTag_Storage);
+        StorageHashGrow(storage, storage->Data.Size ? storage->Data.Size * 2 : 16);
+    }
+    const int mask = storage->Data.Size - 1;
+    for (int i = StorageHashSlot(key, mask); ; i = (i + 1) & mask)
+    {
+        ImGuiStorage::Pair* pair = &storage->Data.Data[i];
+        if (pair->key == key)
+            return pair;
+        if (pair->key == 0)
+        {
+            *pair = default_pair;
+            storage->HashCount++;
+            return pair;
+        }
+    }
+}
+
+void ImGuiStorage::Clear()
+{
+    Data.clear();
+    HashCount = 0;
+    HashHasZeroKey = false;
+}
+
+void ImGuiStorage::SetUseHashTable(bool use_hash_table)
+{
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_Storage);
+    if (UseHashTable == use_hash_table)
+        return;
+    ImVector<Pair> pairs;
+    for (int n = 0; n < Data.Size; n++)
+        if (Data[n].key != 0 || !UseHashTable)
+            pairs.push_back(Data[n]);
+    if (UseHashTable && HashHasZeroKey)
+        pairs.push_back(HashZeroKeyPair);
+    Clear();
+    UseHashTable = use_hash_table;
+    if (!UseHashTable)
+    {
+        Data.swap(pairs);
+        BuildSortByKey();
+        return;
+    }
+    int size = 16;
+    while (pairs.Size * 4 > size * 3)
+        size *= 2;
+    Data.resize(size, Pair(0, (void*)NULL));
+    for (int n = 0; n < pairs.Size; n++)
+        StorageFindOrInsertPair(this, pairs[n]);
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -1442,16 +1727,16 @@ void ImGuiStorage::BuildSortByKey()
             return 0;
         }
     };
+    if (UseHashTable)   // Not ordered
+        return;
     if (Data.Size > 1)
         qsort(Data.Data, (size_t)Data.Size, sizeof(Pair), StaticFunc::PairCompareByID);
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImVector<Pair>::iterator it = LowerBound(const_cast<ImVector<ImGuiStorage::Pair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    const Pair* pair = StorageFindPair(this, key);
+    return pair ? pair->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -1461,27 +1746,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImVector<Pair>::iterator it = LowerBound(const_cast<ImVector<ImGuiStorage::Pair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    const Pair* pair = StorageFindPair(this, key);
+    return pair ? pair->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImVector<Pair>::iterator it = LowerBound(const_cast<ImVector<ImGuiStorage::Pair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    const Pair* pair = StorageFindPair(this, key);
+    return pair ? pair->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, Pair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrInsertPair(this, Pair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -1491,30 +1769,18 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, Pair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrInsertPair(this, Pair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, Pair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrInsertPair(this, Pair(key, default_val))->val_p;
 }
 
 // FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, Pair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrInsertPair(this, Pair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -1524,30 +1790,19 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, Pair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrInsertPair(this, Pair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImVector<Pair>::iterator it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, Pair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrInsertPair(this, Pair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
 {
     for (int i = 0; i < Data.Size; i++)
-        Data[i].val_i = v;
+        Data[i].val_i = v;  // Free slots of the hash table included: harmless
+    HashZeroKeyPair.val_i = v;
 }
 
 //-----------------------------------------------------------------------------
@@ -1663,6 +1918,7 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 // Helper: Text buffer for logging/accumulating text
 void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_TextBuffer);
     va_list args_copy;
     va_copy(args_copy, args);
 
@@ -1860,6 +2116,7 @@ ImGuiWindow::ImGuiWindow(const char* name)
     LastFrameActive = -1;
     ItemWidthDefault = 0.0f;
     FontWindowScale = 1.0f;
+    StateStorage.SetUseHashTable(true);    // Trees with thousands of nodes insert and look up their open state here
 
     DrawList = (ImDrawList*)ImGui::MemAlloc(sizeof(ImDrawList));
     IM_PLACEMENT_NEW(DrawList) ImDrawList();
@@ -2149,17 +2406,218 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
+//-----------------------------------------------------------------------------
+// Allocation statistics by subsystem (ImGuiMemTag)
+//-----------------------------------------------------------------------------
+
+// The lock also guards io.MetricsAllocs, which the dock draw threads update through MemAlloc()/MemFree() even when the tags are disabled
+static std::atomic_flag         GImMemTagsLock = ATOMIC_FLAG_INIT;
+
+static inline void MemTagsLock()   { while (GImMemTagsLock.test_and_set(std::memory_order_acquire)) {} }
+static inline void MemTagsUnlock() { GImMemTagsLock.clear(std::memory_order_release); }
+
+#ifndef IMGUI_DISABLE_MEM_TAGS
+
+// The size and tag of each live allocation are kept in a hash table keyed by address (open addressing with linear probing, deletion by backward
+// shift), so that MemFree() needs no header in front of the memory: memory allocated by the user and handed over to ImGui (e.g. the font data
+// of AddFontFromMemoryTTF()) can still be freed with MemFree(), it is just not found in the table. The table is shared by all contexts and
+// allocated with malloc() as it may outlive them. It is guarded by a spin lock as the dock draw threads allocate too. Steady-state frames don't
+// allocate, so none of this is on the hot path.
+struct ImGuiMemTagEntry
+{
+    void*           Ptr;                // NULL = free slot
+    size_t          Size;
+    ImGuiMemTag     Tag;
+};
+
+struct ImGuiMemTagCounters             // POD so that the statics below are zero-initialized before any dynamic initialization
+{
+    size_t          BytesLive, BytesPeak;
+    int             AllocsLive;
+    int             Allocs, Frees;      // During the current frame
+    int             AllocsLastFrame, FreesLastFrame;
+};
+
+static thread_local ImGuiMemTag GImMemTag = ImGuiMemTag_Other;
+static ImGuiMemTagEntry*        GImMemTagsTable = NULL;
+static int                      GImMemTagsTableSize = 0;    // Power of two
+static int                      GImMemTagsTableCount = 0;
+static ImGuiMemTagCounters      GImMemTagsCounters[ImGuiMemTag_Count_];
+
+static inline int MemTagsSlot(const void* ptr, int mask)
+{
+    ImU64 h = (ImU64)(uintptr_t)ptr >> 4;   // Allocations are at least 16-byte aligned on most platforms
+    h ^= h >> 29;
+    h *= 0x9E3779B97F4A7C15ULL;
+    return (int)(h >> 32) & mask;
+}
+
+static bool MemTagsGrowTable()
+{
+    const int new_size = GImMemTagsTableSize ? GImMemTagsTableSize * 2 : 1024;
+    ImGuiMemTagEntry* new_table = (ImGuiMemTagEntry*)malloc((size_t)new_size * sizeof(ImGuiMemTagEntry));
+    if (!new_table)
+        return false;
+    memset(new_table, 0, (size_t)new_size * sizeof(ImGuiMemTagEntry));
+    for (int n = 0; n < GImMemTagsTableSize; n++)
+    {
+        if (!GImMemTagsTable[n].Ptr)
+            continue;
+        int i = MemTagsSlot(GImMemTagsTable[n].Ptr, new_size - 1);
+        while (new_table[i].Ptr)
+            i = (i + 1) & (new_size - 1);
+        new_table[i] = GImMemTagsTable[n];
+    }
+    free(GImMemTagsTable);
+    GImMemTagsTable = new_table;
+    GImMemTagsTableSize = new_size;
+    return true;
+}
+
+// MemTagsInsert() and MemTagsRemove() are called with the lock held
+static void MemTagsInsert(void* ptr, size_t sz, ImGuiMemTag tag)
+{
+    if ((GImMemTagsTableCount + 1) * 4 > GImMemTagsTableSize * 3 && !MemTagsGrowTable() && GImMemTagsTableCount + 1 >= GImMemTagsTableSize)
+        return;             // Out of memory for the table: this allocation is not accounted for
+    const int mask = GImMemTagsTableSize - 1;
+    int i = MemTagsSlot(ptr, mask);
+    while (GImMemTagsTable[i].Ptr)
+        i = (i + 1) & mask;
+    GImMemTagsTable[i].Ptr = ptr;
+    GImMemTagsTable[i].Size = sz;
+    GImMemTagsTable[i].Tag = tag;
+    GImMemTagsTableCount++;
+    ImGuiMemTagCounters& c = GImMemTagsCounters[tag];
+    c.BytesLive += sz;
+    if (c.BytesLive > c.BytesPeak)
+        c.BytesPeak = c.BytesLive;
+    c.AllocsLive++;
+    c.Allocs++;
+}
+
+static void MemTagsRemove(void* ptr)
+{
+    const int mask = GImMemTagsTableSize - 1;
+    int i = GImMemTagsTableSize ? MemTagsSlot(ptr, mask) : 0;
+    while (GImMemTagsTableSize && GImMemTagsTable[i].Ptr && GImMemTagsTable[i].Ptr != ptr)
+        i = (i + 1) & mask;
+    if (!GImMemTagsTableSize || !GImMemTagsTable[i].Ptr)
+        return;             // Not allocated with MemAlloc()
+    ImGuiMemTagCounters& c = GImMemTagsCounters[GImMemTagsTable[i].Tag];
+    c.BytesLive -= GImMemTagsTable[i].Size;
+    c.AllocsLive--;
+    c.Frees++;
+
+    // Move back the entries of the same probe sequence that follow the free slot
+    for (int j = (i + 1) & mask; GImMemTagsTable[j].Ptr; j = (j + 1) & mask)
+    {
+        const int k = MemTagsSlot(GImMemTagsTable[j].Ptr, mask);
+        if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        GImMemTagsTable[i] = GImMemTagsTable[j];
+        i = j;
+    }
+    GImMemTagsTable[i].Ptr = NULL;
+    GImMemTagsTableCount--;
+}
+
+void ImGui::MemTagTrackAlloc(void* ptr, size_t sz, ImGuiMemTag tag)
+{
+    if (!ptr)
+        return;
+    MemTagsLock();
+    MemTagsInsert(ptr, sz, tag);
+    MemTagsUnlock();
+}
+
+void ImGui::MemTagTrackFree(void* ptr)
+{
+    if (!ptr)
+        return;
+    MemTagsLock();
+    MemTagsRemove(ptr);
+    MemTagsUnlock();
+}
+
+void ImGui::MemTagsNewFrame()
+{
+    MemTagsLock();
+    for (int n = 0; n < ImGuiMemTag_Count_; n++)
+    {
+        ImGuiMemTagCounters& c = GImMemTagsCounters[n];
+        c.AllocsLastFrame = c.Allocs;
+        c.FreesLastFrame = c.Frees;
+        c.Allocs = c.Frees = 0;
+    }
+    MemTagsUnlock();
+}
+
+ImGuiMemTag ImGui::SetMemTag(ImGuiMemTag tag)
+{
+    IM_ASSERT(tag >= 0 && tag < ImGuiMemTag_Count_);
+    ImGuiMemTag backup_tag = GImMemTag;
+    GImMemTag = tag;
+    return backup_tag;
+}
+
+bool ImGui::GetMemTagStats(ImGuiMemTag tag, ImGuiMemTagStats* out_stats)
+{
+    IM_ASSERT(tag >= 0 && tag < ImGuiMemTag_Count_);
+    MemTagsLock();
+    const ImGuiMemTagCounters& c = GImMemTagsCounters[tag];
+    out_stats->BytesLive = c.BytesLive;
+    out_stats->BytesPeak = c.BytesPeak;
+    out_stats->AllocsLive = c.AllocsLive;
+    out_stats->AllocsLastFrame = c.AllocsLastFrame;
+    out_stats->FreesLastFrame = c.FreesLastFrame;
+    MemTagsUnlock();
+    return true;
+}
+
+#else
+
+void        ImGui::MemTagTrackAlloc(void*, size_t, ImGuiMemTag) {}
+void        ImGui::MemTagTrackFree(void*) {}
+void        ImGui::MemTagsNewFrame() {}
+ImGuiMemTag ImGui::SetMemTag(ImGuiMemTag) { return ImGuiMemTag_Other; }
+bool        ImGui::GetMemTagStats(ImGuiMemTag, ImGuiMemTagStats* out_stats) { *out_stats = ImGuiMemTagStats(); return false; }
+
+#endif // #ifndef IMGUI_DISABLE_MEM_TAGS
+
+const char* ImGui::GetMemTagName(ImGuiMemTag tag)
+{
+    static const char* names[] = { "Other", "DrawList", "Window", "Storage", "FontAtlas", "TextBuffer", "DockNode", "DockMap" };
+    IM_ASSERT(IM_ARRAYSIZE(names) == ImGuiMemTag_Count_ && tag >= 0 && tag < ImGuiMemTag_Count_);
+    return names[tag];
+}
+
 //-----------------------------------------------------------------------------
 
+// io.MetricsAllocs is updated under the same lock as the tag counters, so that both agree
 void* ImGui::MemAlloc(size_t sz)
 {
+    void* ptr = GImGui->IO.MemAllocFn(sz);
+    MemTagsLock();
     GImGui->IO.MetricsAllocs++;
-    return GImGui->IO.MemAllocFn(sz);
+#ifndef IMGUI_DISABLE_MEM_TAGS
+    if (ptr)
+        MemTagsInsert(ptr, sz, GImMemTag);
+#endif
+    MemTagsUnlock();
+    return ptr;
 }
 
 void ImGui::MemFree(void* ptr)
 {
-    if (ptr) GImGui->IO.MetricsAllocs--;
+    if (ptr)
+    {
+        MemTagsLock();
+        GImGui->IO.MetricsAllocs--;
+#ifndef IMGUI_DISABLE_MEM_TAGS
+        MemTagsRemove(ptr);
+#endif
+        MemTagsUnlock();
+    }
     return GImGui->IO.MemFreeFn(ptr);
 }
 
@@ -2258,13 +2716,21 @@ void ImGui::NewFrame()
     if (!g.Initialized)
         ImGui::Initialize();
 
+    // Load the glyphs requested by FindGlyph() in the previous frame
+    g.IO.Fonts->UpdateDynamicGlyphs();
+
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
 
     g.Time += g.IO.DeltaTime;
     g.FrameCount += 1;
+    MemTagsNewFrame();
+    g.TextSizeCache.HitsLastFrame = g.TextSizeCache.Hits;
+    g.TextSizeCache.MissesLastFrame = g.TextSizeCache.Misses;
+    g.TextSizeCache.Hits = g.TextSizeCache.Misses = 0;
     g.TooltipOverrideCount = 0;
     g.OverlayDrawList.Clear();
+    g.OverlayDrawList._AllowVtxOffset = g.IO.RendererHasVtxOffset;
     g.OverlayDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.OverlayDrawList.PushClipRectFullScreen();
 
@@ -2370,7 +2836,7 @@ void ImGui::NewFrame()
     {
         g.SettingsDirtyTimer -= g.IO.DeltaTime;
         if (g.SettingsDirtyTimer <= 0.0f)
-            SaveIniSettingsToDisk(g.IO.IniFilename);
+            SaveIniSettingsToDisk(g.IO.IniFilename, true);
     }
 
     // Find the window we are hovering
@@ -2452,6 +2918,25 @@ void ImGui::NewFrame()
     if (g.ActiveId == 0 && g.NavWindow != NULL && g.NavWindow->Active && IsKeyPressedMap(ImGuiKey_Tab, false))
         g.NavWindow->FocusIdxTabRequestNext = 0;
 
+    // Give back the memory of draw lists that stayed mostly empty or were not drawn for a while, and sum what the draw lists hold
+    size_t memory_before = 0, memory_after = 0;
+    for (int i = 0; i != g.Windows.Size; i++)
+    {
+        ImDrawList* draw_list = g.Windows[i]->DrawList;
+        size_t memory = draw_list->GetMemoryUsage();
+        memory_before += memory;
+        if (g.IO.DrawListShrinkFrames > 0 && TrimWindowDrawList(g.Windows[i]))
+            memory = draw_list->GetMemoryUsage();
+        memory_after += memory;
+    }
+    if (memory_after != memory_before)
+    {
+        g.DrawListsMemoryBeforeTrim = memory_before;
+        g.DrawListsMemoryAfterTrim = memory_after;
+        g.DrawListsTrimFrame = g.FrameCount;
+    }
+    g.DrawListsMemory = memory_after;
+
     // Mark all windows as not visible
     for (int i = 0; i != g.Windows.Size; i++)
     {
@@ -2565,6 +3050,7 @@ void ImGui::Shutdown()
         return;
 
     SaveIniSettingsToDisk(g.IO.IniFilename);
+    ShutdownSettingsWriter();   // Wait for the pending write
 
     for (int i = 0; i < g.Windows.Size; i++)
     {
@@ -2593,12 +3079,22 @@ void ImGui::Shutdown()
     for (int i = 0; i < IM_ARRAYSIZE(g.RenderDrawLists); i++)
         g.RenderDrawLists[i].clear();
     g.OverlayDrawList.ClearFreeMemory();
+    for (int i = 0; i < g.MergedDrawLists.Size; i++)
+    {
+        g.MergedDrawLists[i]->~ImDrawList();
+        ImGui::MemFree(g.MergedDrawLists[i]);
+    }
+    g.MergedDrawLists.clear();
+    g.MergedDrawListsActive.clear();
     g.PrivateClipboard.clear();
+    g.TextSizeCache.Clear();
+    g.DeIndexVtxBuffer.clear();
     g.InputTextState.Text.clear();
     g.InputTextState.InitialText.clear();
     g.InputTextState.TempTextBuffer.clear();
 
     g.SettingsWindows.clear();
+    g.SettingsWindowsIndex.Clear();
     g.SettingsHandlers.clear();
 
     if (g.LogFile && g.LogFile != stdout)
@@ -2618,10 +3114,8 @@ void ImGui::Shutdown()
 ImGuiWindowSettings* ImGui::FindWindowSettings(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    for (int i = 0; i != g.SettingsWindows.Size; i++)
-        if (g.SettingsWindows[i].Id == id)
-            return &g.SettingsWindows[i];
-    return NULL;
+    int index = g.SettingsWindowsIndex.GetInt(id, 0);
+    return index ? &g.SettingsWindows[index - 1] : NULL;
 }
 
 static ImGuiWindowSettings* AddWindowSettings(const char* name)
@@ -2631,6 +3125,9 @@ static ImGuiWindowSettings* AddWindowSettings(const char* name)
     ImGuiWindowSettings* settings = &g.SettingsWindows.back();
     settings->Name = ImStrdup(name);
     settings->Id = ImHash(name, 0);
+    int* index = g.SettingsWindowsIndex.GetIntRef(settings->Id, 0);
+    if (*index == 0) // Keep the first entry if two names have the same ID, as the linear search did
+        *index = g.SettingsWindows.Size;
     return settings;
 }
 
@@ -2707,21 +3204,103 @@ static void LoadIniSettingsFromMemory(const char* buf_readonly)
     ImGui::MemFree(buf);
 }
 
-static void SaveIniSettingsToDisk(const char* ini_filename)
+// A .ini file to write. The .ini file is written to TmpFilename first and then renamed, so an interrupted save never leaves a truncated file behind.
+struct ImGuiSettingsWriteJob
+{
+    ImVector<char>          Data;
+    ImVector<char>          Filename;
+    ImVector<char>          TmpFilename;
+
+    void swap(ImGuiSettingsWriteJob& rhs) { Data.swap(rhs.Data); Filename.swap(rhs.Filename); TmpFilename.swap(rhs.TmpFilename); }
+};
+
+#ifndef IMGUI_DISABLE_INI_SAVE_THREAD
+// Writes the .ini file in the background so that a slow disk (e.g. a network home directory) never stalls NewFrame().
+// Only the latest settings matter: a save requested while the previous one is being written replaces the pending one.
+// The writer thread never allocates: the main thread swaps its serialized job with Pending, and the writer swaps Pending with Writing.
+struct ImGuiSettingsWriter
+{
+    std::thread             Thread;
+    std::mutex              Mutex;
+    std::condition_variable Cond;
+    ImGuiSettingsWriteJob   Pending;
+    ImGuiSettingsWriteJob   Writing;
+    bool                    HasPending;
+    bool                    Quit;
+
+    ImGuiSettingsWriter() { HasPending = Quit = false; Thread = std::thread(&ImGuiSettingsWriter::Run, this); }
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(Mutex);
+        for (;;)
+        {
+            Cond.wait(lock, [this] { return HasPending || Quit; });
+            if (!HasPending)
+                return;
+            Writing.swap(Pending);
+            HasPending = false;
+            lock.unlock();
+            ImFileWriteAtomic(Writing.Filename.Data, Writing.TmpFilename.Data, Writing.Data.Data, (size_t)Writing.Data.Size);
+            lock.lock();
+        }
+    }
+};
+#endif
+
+static void SaveIniSettingsToDisk(const char* ini_filename, bool background)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
     if (!ini_filename)
         return;
 
-    ImVector<char> buf;
-    SaveIniSettingsToMemory(buf);
+    ImGuiSettingsWriteJob job;
+    SaveIniSettingsToMemory(job.Data);
+    const int filename_len = (int)strlen(ini_filename);
+    job.Filename.resize(filename_len + 1);
+    memcpy(job.Filename.Data, ini_filename, (size_t)filename_len + 1);
+    job.TmpFilename.resize(filename_len + 5);
+    ImFormatString(job.TmpFilename.Data, (size_t)job.TmpFilename.Size, "%s.tmp", ini_filename);
 
-    FILE* f = ImFileOpen(ini_filename, "wt");
-    if (!f)
+#ifndef IMGUI_DISABLE_INI_SAVE_THREAD
+    if (background && !g.SettingsWriter)
+    {
+        g.SettingsWriter = (ImGuiSettingsWriter*)ImGui::MemAlloc(sizeof(ImGuiSettingsWriter));
+        IM_PLACEMENT_NEW(g.SettingsWriter) ImGuiSettingsWriter();
+    }
+    if (g.SettingsWriter)
+    {
+        // The previous pending job (if any) is freed here, on this thread
+        std::lock_guard<std::mutex> lock(g.SettingsWriter->Mutex);
+        g.SettingsWriter->Pending.swap(job);
+        g.SettingsWriter->HasPending = true;
+        g.SettingsWriter->Cond.notify_one();
         return;
-    fwrite(buf.Data, sizeof(char), (size_t)buf.Size, f);
-    fclose(f);
+    }
+#else
+    (void)background;
+#endif
+    ImFileWriteAtomic(job.Filename.Data, job.TmpFilename.Data, job.Data.Data, (size_t)job.Data.Size);
+}
+
+// Finish the pending write and stop the writer thread
+static void ShutdownSettingsWriter()
+{
+#ifndef IMGUI_DISABLE_INI_SAVE_THREAD
+    ImGuiContext& g = *GImGui;
+    if (!g.SettingsWriter)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(g.SettingsWriter->Mutex);
+        g.SettingsWriter->Quit = true;
+        g.SettingsWriter->Cond.notify_one();
+    }
+    g.SettingsWriter->Thread.join();
+    g.SettingsWriter->~ImGuiSettingsWriter();
+    ImGui::MemFree(g.SettingsWriter);
+    g.SettingsWriter = NULL;
+#endif
 }
 
 static void SaveIniSettingsToMemory(ImVector<char>& out_buf)
@@ -2800,7 +3379,7 @@ static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDr
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc. May trigger for you if you are using PrimXXX functions incorrectly.
     IM_ASSERT(draw_list->VtxBuffer.Size == 0 || draw_list->_VtxWritePtr == draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size);
     IM_ASSERT(draw_list->IdxBuffer.Size == 0 || draw_list->_IdxWritePtr == draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size);
-    IM_ASSERT((int)draw_list->_VtxCurrentIdx == draw_list->VtxBuffer.Size);
+    IM_ASSERT((int)(draw_list->_VtxCurrentOffset + draw_list->_VtxCurrentIdx) == draw_list->VtxBuffer.Size);
 
     // Check that draw_list doesn't use more vertices than indexable in a single draw call (default ImDrawIdx = unsigned short = 2 bytes = 64K vertices per window)
     // If this assert triggers because you are drawing lots of stuff manually, you can:
@@ -2809,11 +3388,17 @@ static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDr
     //    'glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);'
     //    Your own engine or render API may use different parameters or function calls to specify index sizes. 2 and 4 bytes indices are generally supported by most API.
     // B) If for some reason you cannot use 4 bytes indices or don't want to, a workaround is to call BeginChild()/EndChild() before reaching the 64K limit to split your draw commands in multiple draw lists.
+    // C) If your renderer honors ImDrawCmd::VtxOffset, set io.RendererHasVtxOffset and the draw list will start a new vertex offset every 64K vertices.
     IM_ASSERT(((ImU64)draw_list->_VtxCurrentIdx >> (sizeof(ImDrawIdx)*8)) == 0);  // Too many vertices in same ImDrawList. See comment above.
     
     out_render_list.push_back(draw_list);
     GImGui->IO.MetricsRenderVertices += draw_list->VtxBuffer.Size;
     GImGui->IO.MetricsRenderIndices += draw_list->IdxBuffer.Size;
+
+    // Peak usage for the trimming in NewFrame(), taken before the renderer or DeIndexAllBuffers() change the buffers
+    draw_list->_ShrinkPeakCmd = ImMax(draw_list->_ShrinkPeakCmd, draw_list->CmdBuffer.Size);
+    draw_list->_ShrinkPeakIdx = ImMax(draw_list->_ShrinkPeakIdx, draw_list->IdxBuffer.Size);
+    draw_list->_ShrinkPeakVtx = ImMax(draw_list->_ShrinkPeakVtx, draw_list->VtxBuffer.Size);
 }
 
 static void AddWindowToRenderList(ImVector<ImDrawList*>& out_render_list, ImGuiWindow* window)
@@ -2843,6 +3428,138 @@ static void AddWindowToRenderListSelectLayer(ImGuiWindow* window)
         AddWindowToRenderList(g.RenderDrawLists[0], window);
 }
 
+// Called from NewFrame() while the draw list still holds the previous frame. The buffers only grow while drawing, so a list that once held a large
+// plot keeps its memory after the window goes back to a few widgets. Once the usage stayed under a quarter of the capacity for io.DrawListShrinkFrames
+// frames in a row, shrink to 1.5x the peak usage seen in that time, which leaves room for the usual variation without growing again. A window that was
+// not drawn for io.DrawListShrinkFrames frames gives back everything. Small lists are left alone. Returns true if some memory was given back.
+static bool TrimWindowDrawList(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawList* draw_list = window->DrawList;
+    const int frames = g.IO.DrawListShrinkFrames;
+    if (window->LastFrameActive < g.FrameCount - 1 - frames)
+    {
+        if (draw_list->CmdBuffer.Capacity == 0 && draw_list->VtxBuffer.Capacity == 0 && draw_list->IdxBuffer.Capacity == 0)
+            return false;
+        draw_list->ClearFreeMemory();
+        return true;
+    }
+    if (window->LastFrameActive != g.FrameCount - 1)
+        return false;
+
+    draw_list->_ShrinkPeakCmd = ImMax(draw_list->_ShrinkPeakCmd, draw_list->CmdBuffer.Size);
+    draw_list->_ShrinkPeakIdx = ImMax(draw_list->_ShrinkPeakIdx, draw_list->IdxBuffer.Size);
+    draw_list->_ShrinkPeakVtx = ImMax(draw_list->_ShrinkPeakVtx, draw_list->VtxBuffer.Size);
+    const size_t capacity_bytes = (size_t)draw_list->IdxBuffer.Capacity * sizeof(ImDrawIdx) + (size_t)draw_list->VtxBuffer.Capacity * sizeof(ImDrawVert);
+    const bool mostly_unused = capacity_bytes >= 16 * 1024 && (draw_list->_ShrinkPeakIdx * 4 < draw_list->IdxBuffer.Capacity || draw_list->_ShrinkPeakVtx * 4 < draw_list->VtxBuffer.Capacity);
+    if (!mostly_unused)
+    {
+        draw_list->_ShrinkFrames = draw_list->_ShrinkPeakCmd = draw_list->_ShrinkPeakIdx = draw_list->_ShrinkPeakVtx = 0;
+        return false;
+    }
+    if (++draw_list->_ShrinkFrames < frames)
+        return false;
+
+    const size_t memory = draw_list->GetMemoryUsage();
+    draw_list->ShrinkBuffers(draw_list->_ShrinkPeakCmd + draw_list->_ShrinkPeakCmd / 2, draw_list->_ShrinkPeakIdx + draw_list->_ShrinkPeakIdx / 2, draw_list->_ShrinkPeakVtx + draw_list->_ShrinkPeakVtx / 2);
+    draw_list->_ShrinkFrames = draw_list->_ShrinkPeakCmd = draw_list->_ShrinkPeakIdx = draw_list->_ShrinkPeakVtx = 0;
+    return draw_list->GetMemoryUsage() != memory;
+}
+
+// Geometry contained in both clipping rectangles renders the same with either of them, so the commands can be joined. Rectangles are rounded inwards because renderers typically truncate them to integers.
+static bool IsDrawCmdClipCompatible(const ImVec4& clip_a, const ImVec4& clip_b, const ImRect& bb)
+{
+    if (clip_a.x == clip_b.x && clip_a.y == clip_b.y && clip_a.z == clip_b.z && clip_a.w == clip_b.w)
+        return true;
+    return bb.Min.x >= ImMax(ceilf(clip_a.x), ceilf(clip_b.x)) && bb.Min.y >= ImMax(ceilf(clip_a.y), ceilf(clip_b.y)) &&
+           bb.Max.x <= ImMin(floorf(clip_a.z), floorf(clip_b.z)) && bb.Max.y <= ImMin(floorf(clip_a.w), floorf(clip_b.w));
+}
+
+// Concatenate the draw lists into as few lists as the index type allows, and join consecutive draw commands that share the texture and have compatible clipping rectangles.
+// The vertices of each command are copied and its indices rebased, so source lists that roll over to several VtxOffset are handled too. With io.RendererHasVtxOffset the output
+// is a single list in which a new VtxOffset starts every 64K vertices. Drawing order is preserved. Callbacks are kept as separate commands but receive the merged list as parent_list.
+static void MergeDrawCommands(ImDrawData* draw_data)
+{
+    ImGuiContext& g = *GImGui;
+    const ImU64 max_vtx = (ImU64)1 << (sizeof(ImDrawIdx) * 8);
+    int merged_count = 0;
+    ImDrawList* dst = NULL;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* src = draw_data->CmdLists[n];
+        const ImDrawIdx* idx_read = src->IdxBuffer.Data;
+        for (const ImDrawCmd* pcmd = src->CmdBuffer.begin(); pcmd != src->CmdBuffer.end(); idx_read += pcmd->ElemCount, pcmd++)
+        {
+            if (pcmd->ElemCount == 0 && pcmd->UserCallback == NULL)
+                continue;
+
+            // Range of vertices used by this command
+            unsigned int vtx_min = 0, vtx_max = 0;
+            for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+            {
+                vtx_min = (i == 0 || idx_read[i] < vtx_min) ? idx_read[i] : vtx_min;
+                vtx_max = (i == 0 || idx_read[i] > vtx_max) ? idx_read[i] : vtx_max;
+            }
+            const unsigned int vtx_count = pcmd->ElemCount > 0 ? vtx_max - vtx_min + 1 : 0;
+
+            // Start a new list (or vertex offset) when the indices would overflow
+            if (!dst || (ImU64)dst->_VtxCurrentIdx + vtx_count > max_vtx)
+            {
+                if (dst && g.IO.RendererHasVtxOffset)
+                {
+                    dst->_VtxCurrentOffset = (unsigned int)dst->VtxBuffer.Size;
+                    dst->_VtxCurrentIdx = 0;
+                }
+                else
+                {
+                    if (merged_count == g.MergedDrawLists.Size)
+                    {
+                        ImDrawList* draw_list = (ImDrawList*)ImGui::MemAlloc(sizeof(ImDrawList));
+                        IM_PLACEMENT_NEW(draw_list) ImDrawList();
+                        draw_list->_OwnerName = "##Merged";
+                        g.MergedDrawLists.push_back(draw_list);
+                    }
+                    dst = g.MergedDrawLists[merged_count++];
+                    dst->Clear();
+                }
+            }
+
+            const int vtx_write = dst->VtxBuffer.Size;
+            dst->VtxBuffer.resize(vtx_write + vtx_count);
+            if (vtx_count > 0)
+                memcpy(dst->VtxBuffer.Data + vtx_write, src->VtxBuffer.Data + pcmd->VtxOffset + vtx_min, vtx_count * sizeof(ImDrawVert));
+            const int idx_write = dst->IdxBuffer.Size;
+            dst->IdxBuffer.resize(idx_write + pcmd->ElemCount);
+            for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+                dst->IdxBuffer.Data[idx_write + i] = (ImDrawIdx)(idx_read[i] - vtx_min + dst->_VtxCurrentIdx);
+            dst->_VtxCurrentIdx += vtx_count;
+
+            ImDrawCmd* last = dst->CmdBuffer.Size > 0 ? &dst->CmdBuffer.back() : NULL;
+            if (last && !last->UserCallback && !pcmd->UserCallback && last->TextureId == pcmd->TextureId && last->VtxOffset == dst->_VtxCurrentOffset)
+            {
+                ImRect bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                if (memcmp(&last->ClipRect, &pcmd->ClipRect, sizeof(ImVec4)) != 0)
+                    for (unsigned int i = 0; i < vtx_count; i++)
+                        bb.Add(dst->VtxBuffer.Data[vtx_write + i].pos);
+                if (IsDrawCmdClipCompatible(last->ClipRect, pcmd->ClipRect, bb))
+                {
+                    last->ElemCount += pcmd->ElemCount;
+                    continue;
+                }
+            }
+            dst->CmdBuffer.push_back(*pcmd);
+            dst->CmdBuffer.back().VtxOffset = dst->_VtxCurrentOffset;
+        }
+    }
+
+    g.MergedDrawListsActive.resize(0);
+    for (int i = 0; i < merged_count; i++)
+        if (!g.MergedDrawLists[i]->CmdBuffer.empty())
+            g.MergedDrawListsActive.push_back(g.MergedDrawLists[i]);
+    draw_data->CmdLists = g.MergedDrawListsActive.Size > 0 ? &g.MergedDrawListsActive[0] : NULL;
+    draw_data->CmdListsCount = g.MergedDrawListsActive.Size;
+}
+
 // When using this function it is sane to ensure that float are perfectly rounded to integer values, to that e.g. (int)(max.x-min.x) in user's render produce correct result.
 void ImGui::PushClipRect(const ImVec2& clip_rect_min, const ImVec2& clip_rect_max, bool intersect_with_current_clip_rect)
 {
@@ -3010,6 +3727,11 @@ void ImGui::Render()
         g.RenderDrawData.CmdListsCount = g.RenderDrawLists[0].Size;
         g.RenderDrawData.TotalVtxCount = g.IO.MetricsRenderVertices;
         g.RenderDrawData.TotalIdxCount = g.IO.MetricsRenderIndices;
+        if (g.IO.OptMergeDrawCommands)
+            MergeDrawCommands(&g.RenderDrawData);
+        g.IO.MetricsRenderCmds = 0;
+        for (int i = 0; i < g.RenderDrawData.CmdListsCount; i++)
+            g.IO.MetricsRenderCmds += g.RenderDrawData.CmdLists[i]->CmdBuffer.Size;
 
         // Render. If user hasn't set a callback then they may retrieve the draw data via GetDrawData()
         if (g.RenderDrawData.CmdListsCount > 0 && g.IO.RenderDrawListsFn != NULL)
@@ -3140,7 +3862,15 @@ void ImGui::RenderTextWrapped(ImVec2 pos, const char* text, const char* text_end
     const int text_len = (int)(text_end - text);
     if (text_len > 0)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        // Reuse the ends of the wrapped lines found by CalcTextSize() if they are still in the cache
+        const ImU32 col = GetColorU32(ImGuiCol_Text);
+        const ImGuiTextSizeCacheEntry* entry = NULL;
+        if (wrap_width > 0.0f && g.IO.TextSizeCacheCapacity > 0 && !g.DrawingInParallel && (col & IM_COL32_A_MASK) != 0)
+            entry = g.TextSizeCache.Find(ImHash64(text, text_len), text_len, g.Font, g.FontSize, wrap_width);
+        if (entry)
+            g.Font->RenderText(window->DrawList, g.FontSize, pos, col, window->DrawList->_ClipRectStack.back(), text, text_end, wrap_width, false, entry->WrapEolsCount > 0 ? g.TextSizeCache.WrapEols.Data + entry->WrapEolsOffset : NULL);
+        else
+            window->DrawList->AddText(g.Font, g.FontSize, pos, col, text, text_end, wrap_width);
         if (g.LogEnabled)
             LogRenderedText(&pos, text, text_end);
     }
@@ -3275,6 +4005,129 @@ void ImGui::RenderCheckMark(ImVec2 pos, ImU32 col, float sz)
     window->DrawList->PathStroke(col, false, thickness);
 }
 
+void ImGuiTextSizeCache::Clear()
+{
+    Entries.clear();
+    Buckets.clear();
+    WrapEols.clear();
+    WrapEolsSpare.clear();
+    WrapEolsLive = 0;
+    Capacity = 0;
+    LruFirst = LruLast = -1;
+}
+
+ImGuiTextSizeCacheEntry* ImGuiTextSizeCache::Find(ImU64 hash, int text_len, const ImFont* font, float font_size, float wrap_width)
+{
+    if (Buckets.empty())
+        return NULL;
+    const int generation = font->ContainerAtlas ? font->ContainerAtlas->Generation : 0;
+    for (int n = Buckets[(int)(hash & (ImU64)(Buckets.Size - 1))]; n != -1; n = Entries[n].HashNext)
+    {
+        ImGuiTextSizeCacheEntry& entry = Entries[n];
+        if (entry.Hash != hash || entry.TextLen != text_len || entry.Font != font || entry.FontGeneration != generation || entry.FontSize != font_size || entry.WrapWidth != wrap_width)
+            continue;
+
+        // Move to the front of the LRU list
+        if (LruFirst != n)
+        {
+            Entries[entry.LruPrev].LruNext = entry.LruNext;
+            if (entry.LruNext != -1)
+                Entries[entry.LruNext].LruPrev = entry.LruPrev;
+            else
+                LruLast = entry.LruPrev;
+            entry.LruPrev = -1;
+            entry.LruNext = LruFirst;
+            Entries[LruFirst].LruPrev = n;
+            LruFirst = n;
+        }
+        return &entry;
+    }
+    return NULL;
+}
+
+// Add an entry for a measurement that wasn't found, evicting the least recently used one if the cache is full. Size and the ends of the wrapped lines
+// are left for the caller to fill: it appends the latter to WrapEols and sets WrapEolsCount.
+ImGuiTextSizeCacheEntry* ImGuiTextSizeCache::Add(ImU64 hash, int text_len, const ImFont* font, float font_size, float wrap_width, int capacity)
+{
+    if (Capacity != capacity)
+    {
+        Clear();
+        Capacity = capacity;
+        int buckets_count = 1;
+        while (buckets_count < capacity * 2)
+            buckets_count <<= 1;
+        Buckets.resize(buckets_count, -1);
+        Entries.reserve(capacity);
+    }
+
+    int n;
+    if (Entries.Size < Capacity)
+    {
+        n = Entries.Size;
+        Entries.resize(Entries.Size + 1);
+    }
+    else
+    {
+        // Evict the least recently used entry: unlink it from its hash chain and from the LRU list
+        n = LruLast;
+        int* link = &Buckets[(int)(Entries[n].Hash & (ImU64)(Buckets.Size - 1))];
+        while (*link != n)
+            link = &Entries[*link].HashNext;
+        *link = Entries[n].HashNext;
+        LruLast = Entries[n].LruPrev;
+        if (LruLast != -1)
+            Entries[LruLast].LruNext = -1;
+        else
+            LruFirst = -1;
+        WrapEolsLive -= Entries[n].WrapEolsCount;
+    }
+
+    ImGuiTextSizeCacheEntry& entry = Entries[n];
+    entry.WrapEolsCount = 0;
+
+    // Drop the ends of the wrapped lines of the evicted entries once they take more than half of WrapEols
+    if (WrapEols.Size > WrapEolsLive * 2 + 1024)
+        CompactWrapEols();
+
+    entry.Hash = hash;
+    entry.TextLen = text_len;
+    entry.Font = font;
+    entry.FontGeneration = font->ContainerAtlas ? font->ContainerAtlas->Generation : 0;
+    entry.FontSize = font_size;
+    entry.WrapWidth = wrap_width;
+    entry.Size = ImVec2(0.0f, 0.0f);
+    entry.WrapEolsOffset = WrapEols.Size;
+    int& bucket = Buckets[(int)(hash & (ImU64)(Buckets.Size - 1))];
+    entry.HashNext = bucket;
+    bucket = n;
+    entry.LruPrev = -1;
+    entry.LruNext = LruFirst;
+    if (LruFirst != -1)
+        Entries[LruFirst].LruPrev = n;
+    else
+        LruLast = n;
+    LruFirst = n;
+    return &entry;
+}
+
+void ImGuiTextSizeCache::CompactWrapEols()
+{
+    WrapEolsSpare.resize(0);
+    WrapEolsSpare.reserve(WrapEolsLive);
+    for (int n = 0; n < Entries.Size; n++)
+    {
+        ImGuiTextSizeCacheEntry& entry = Entries[n];
+        const int offset = WrapEolsSpare.Size;
+        if (entry.WrapEolsCount > 0)
+        {
+            WrapEolsSpare.resize(offset + entry.WrapEolsCount);
+            memcpy(WrapEolsSpare.Data + offset, WrapEols.Data + entry.WrapEolsOffset, (size_t)entry.WrapEolsCount * sizeof(int));
+        }
+        entry.WrapEolsOffset = offset;
+    }
+    WrapEols.swap(WrapEolsSpare);
+}
+
 // Calculate text size. Text can be multi-line. Optionally ignore text after a ## marker.
 // CalcTextSize("") should return ImVec2(0.0f, GImGui->FontSize)
 ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_text_after_double_hash, float wrap_width)
@@ -3291,7 +4144,26 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+
+    // Look the measurement up in the cache (text_display_end is always set after FindRenderedTextEnd(), but may be NULL otherwise).
+    // The cache is not used while several threads are recording draw lists.
+    ImGuiTextSizeCacheEntry* entry = NULL;
+    if (g.IO.TextSizeCacheCapacity > 0 && !g.DrawingInParallel)
+    {
+        if (!text_display_end)
+            text_display_end = text + strlen(text);
+        const int text_len = (int)(text_display_end - text);
+        const ImU64 hash = ImHash64(text, text_len);
+        if ((entry = g.TextSizeCache.Find(hash, text_len, font, font_size, wrap_width)) != NULL)
+        {
+            g.TextSizeCache.Hits++;
+            return entry->Size;
+        }
+        g.TextSizeCache.Misses++;
+        entry = g.TextSizeCache.Add(hash, text_len, font, font_size, wrap_width, g.IO.TextSizeCacheCapacity);
+    }
+
+    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL, (entry && wrap_width > 0.0f) ? &g.TextSizeCache.WrapEols : NULL);
 
     // Cancel out character spacing for the last character of a line (it is baked into glyph->AdvanceX field)
     const float font_scale = font_size / font->FontSize;
@@ -3300,6 +4172,12 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
         text_size.x -= character_spacing_x;
     text_size.x = (float)(int)(text_size.x + 0.95f);
 
+    if (entry)
+    {
+        entry->Size = text_size;
+        entry->WrapEolsCount = g.TextSizeCache.WrapEols.Size - entry->WrapEolsOffset;
+        g.TextSizeCache.WrapEolsLive += entry->WrapEolsCount;
+    }
     return text_size;
 }
 
@@ -4063,6 +4941,7 @@ ImGuiWindow* ImGui::FindWindowByName(const char* name)
 
 static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_Window);
     ImGuiContext& g = *GImGui;
 
     // Create window the first time
@@ -4214,6 +5093,7 @@ static ImGuiCol GetWindowBgColorIdxFromFlags(ImGuiWindowFlags flags)
 // - Passing 'bool* p_open' displays a Close button on the upper-right corner of the window, the pointed value will be set to false when the button is pressed.
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_Window);
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL);                        // Window name required
@@ -4333,6 +5213,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // Clear draw list, setup texture, outer clipping rectangle
         window->DrawList->Clear();
+        window->DrawList->_AllowVtxOffset = g.IO.RendererHasVtxOffset;
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         ImRect fullscreen_rect(GetVisibleRect());
         if ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & (ImGuiWindowFlags_ComboBox|ImGuiWindowFlags_Popup)))
@@ -7729,6 +8610,209 @@ void ImGui::PlotHistogram(const char* label, float (*values_getter)(void* data,
     PlotEx(ImGuiPlotType_Histogram, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
 }
 
+void ImGuiPlotMinMax::Clear()
+{
+    Values.clear();
+    for (int k = 0; k < MaxLevels; k++)
+        Levels[k].clear();
+    LevelsCount = 0;
+}
+
+void ImGuiPlotMinMax::Build(const float* values, int count, int stride)
+{
+    Values.resize(0);
+    for (int k = 0; k < MaxLevels; k++)
+        Levels[k].resize(0);
+    LevelsCount = 0;
+    Append(values, count, stride);
+}
+
+void ImGuiPlotMinMax::Append(const float* values, int count, int stride)
+{
+    if (count <= 0)
+        return;
+    const int first = Values.Size;
+    Values.resize(first + count);
+    if (stride == sizeof(float))
+        memcpy(Values.Data + first, values, (size_t)count * sizeof(float));
+    else
+        for (int i = 0; i < count; i++)
+            Values[first + i] = *(const float*)(const void*)((const unsigned char*)values + (size_t)i * stride);
+
+    // Recompute the blocks that contain new values, level by level. A level that did not exist is built whole.
+    const int n = Values.Size;
+    const int levels_count_old = LevelsCount;
+    int block = 4;
+    for (int k = 0; k < MaxLevels && block <= n; k++, block *= 4)
+    {
+        ImVector<ImVec2>& level = Levels[k];
+        const int blocks_count = (n + block - 1) / block;
+        const int i0 = (k < levels_count_old) ? first / block : 0;
+        level.resize(blocks_count);
+        for (int i = i0; i < blocks_count; i++)
+        {
+            ImVec2 mm(FLT_MAX, -FLT_MAX);
+            if (k == 0)
+            {
+                for (int j = i * 4, j_end = ImMin(j + 4, n); j < j_end; j++)
+                {
+                    mm.x = ImMin(mm.x, Values[j]);
+                    mm.y = ImMax(mm.y, Values[j]);
+                }
+            }
+            else
+            {
+                const ImVector<ImVec2>& below = Levels[k-1];
+                for (int j = i * 4, j_end = ImMin(j + 4, below.Size); j < j_end; j++)
+                {
+                    mm.x = ImMin(mm.x, below[j].x);
+                    mm.y = ImMax(mm.y, below[j].y);
+                }
+            }
+            level[i] = mm;
+        }
+        LevelsCount = k + 1;
+    }
+}
+
+ImVec2 ImGuiPlotMinMax::GetMinMax(int idx_begin, int idx_end) const
+{
+    // Take the largest aligned block that fits at each step: at most 3 blocks per level going up, and 3 per level going down.
+    ImVec2 mm(FLT_MAX, -FLT_MAX);
+    idx_begin = ImMax(idx_begin, 0);
+    idx_end = ImMin(idx_end, Values.Size);
+    while (idx_begin < idx_end)
+    {
+        int k = -1, block = 1;
+        while (k + 1 < LevelsCount && (idx_begin & (block * 4 - 1)) == 0 && idx_end - idx_begin >= block * 4)
+        {
+            block *= 4;
+            k++;
+        }
+        if (k < 0)
+        {
+            mm.x = ImMin(mm.x, Values[idx_begin]);
+            mm.y = ImMax(mm.y, Values[idx_begin]);
+        }
+        else
+        {
+            const ImVec2& b = Levels[k][idx_begin / block];
+            mm.x = ImMin(mm.x, b.x);
+            mm.y = ImMax(mm.y, b.y);
+        }
+        idx_begin += block;
+    }
+    return mm;
+}
+
+static float Plot_MinMaxGetter(void* data, int idx)
+{
+    return ((const ImGuiPlotMinMax*)data)->Values[idx];
+}
+
+void ImGui::PlotMinMaxEx(ImGuiPlotType plot_type, const char* label, const ImGuiPlotMinMax& values, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    const ImGuiStyle& style = g.Style;
+
+    // With fewer values than pixels there is nothing to decimate
+    if (graph_size.x == 0.0f)
+        graph_size.x = CalcItemWidth();
+    const int res_w = ImMax((int)(graph_size.x - style.FramePadding.x * 2), 1);
+    if (values.Size() <= res_w)
+    {
+        PlotEx(plot_type, label, &Plot_MinMaxGetter, (void*)&values, values.Size(), 0, overlay_text, scale_min, scale_max, graph_size);
+        return;
+    }
+
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+    if (graph_size.y == 0.0f)
+        graph_size.y = label_size.y + (style.FramePadding.y * 2);
+
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + ImVec2(graph_size.x, graph_size.y));
+    const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
+    const ImRect total_bb(frame_bb.Min, frame_bb.Max + ImVec2(label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f, 0));
+    ItemSize(total_bb, style.FramePadding.y);
+    if (!ItemAdd(total_bb, 0))
+        return;
+    const bool hovered = ItemHoverable(inner_bb, 0);
+
+    // Determine scale from the top of the pyramid if not specified
+    if (scale_min == FLT_MAX || scale_max == FLT_MAX)
+    {
+        const ImVec2 mm = values.GetMinMax(0, values.Size());
+        if (scale_min == FLT_MAX)
+            scale_min = mm.x;
+        if (scale_max == FLT_MAX)
+            scale_max = mm.y;
+    }
+
+    RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+    // Pixel column n shows the values [n*count/res_w, (n+1)*count/res_w)
+    const int count = values.Size();
+    #define PLOT_COLUMN_START(n)    ((int)((ImU64)(n) * (ImU64)count / (ImU64)res_w))
+
+    // Tooltip on hover
+    int n_hovered = -1;
+    if (hovered)
+    {
+        n_hovered = ImClamp((int)(g.IO.MousePos.x - inner_bb.Min.x), 0, res_w - 1);
+        const int idx_begin = PLOT_COLUMN_START(n_hovered), idx_end = PLOT_COLUMN_START(n_hovered + 1);
+        const ImVec2 mm = values.GetMinMax(idx_begin, idx_end);
+        SetTooltip("%d-%d: %8.4g to %8.4g", idx_begin, idx_end - 1, mm.x, mm.y);
+    }
+
+    const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
+    const float histogram_zero_line_t = (scale_min * scale_max < 0.0f) ? (-scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);   // Where does the zero line stands
+    const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
+    const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
+    const float y0 = inner_bb.Min.y, h = inner_bb.Max.y - inner_bb.Min.y;
+
+    for (int n = 0; n < res_w; n++)
+    {
+        // Lines also cover the segment from the last value of the previous column
+        int idx_begin = PLOT_COLUMN_START(n);
+        const int idx_end = PLOT_COLUMN_START(n + 1);
+        if (plot_type == ImGuiPlotType_Lines && n > 0)
+            idx_begin--;
+        const ImVec2 mm = values.GetMinMax(idx_begin, idx_end);
+        float t_top = 1.0f - ImSaturate((mm.y - scale_min) * inv_scale);
+        float t_bottom = 1.0f - ImSaturate((mm.x - scale_min) * inv_scale);
+        if (plot_type == ImGuiPlotType_Histogram)
+        {
+            t_top = ImMin(t_top, 1.0f - histogram_zero_line_t);
+            t_bottom = ImMax(t_bottom, 1.0f - histogram_zero_line_t);
+        }
+        const float x = inner_bb.Min.x + (float)n;
+        const float y_top = y0 + t_top * h;
+        const float y_bottom = ImMax(y0 + t_bottom * h, y_top + 1.0f);
+        window->DrawList->AddRectFilled(ImVec2(x, y_top), ImVec2(x + 1.0f, y_bottom), n == n_hovered ? col_hovered : col_base);
+    }
+    #undef PLOT_COLUMN_START
+
+    // Text overlay
+    if (overlay_text)
+        RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max, overlay_text, NULL, NULL, ImVec2(0.5f,0.0f));
+
+    if (label_size.x > 0.0f)
+        RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
+}
+
+void ImGui::PlotLines(const char* label, const ImGuiPlotMinMax& values, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    PlotMinMaxEx(ImGuiPlotType_Lines, label, values, overlay_text, scale_min, scale_max, graph_size);
+}
+
+void ImGui::PlotHistogram(const char* label, const ImGuiPlotMinMax& values, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    PlotMinMaxEx(ImGuiPlotType_Histogram, label, values, overlay_text, scale_min, scale_max, graph_size);
+}
+
 // size_arg (for each axis) < 0.0f: align to end, 0.0f: auto, > 0.0f: specified size
 void ImGui::ProgressBar(float fraction, const ImVec2& size_arg, const char* overlay)
 {
@@ -8152,6 +9236,7 @@ static bool InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags f
 // FIXME: Rather messy function partly because we are doing UTF8 > u16 > UTF8 conversions on the go to more easily handle stb_textedit calls. Ideally we should stay in UTF-8 all the time. See https://github.com/nothings/stb/issues/188
 bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_TextBuffer);
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return false;
@@ -10863,6 +11948,53 @@ void ImGui::Value(const char* prefix, float v, const char* float_format)
 #include <windows.h>
 #endif
 
+// Write a file atomically: write 'tmp_filename' then rename it over 'filename'. Doesn't allocate, as it runs on the .ini writer thread.
+#if defined(_WIN32) && !defined(__CYGWIN__)
+
+#if !defined(_WINDOWS_)
+#undef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+static bool ImFileWriteAtomic(const char* filename, const char* tmp_filename, const char* data, size_t data_size)
+{
+    // MSVC/Windows file functions don't handle UTF-8 filenames
+    ImWchar wfilename[1024], wtmp_filename[1024];
+    if (ImTextCountCharsFromUtf8(filename, NULL) >= IM_ARRAYSIZE(wfilename) || ImTextCountCharsFromUtf8(tmp_filename, NULL) >= IM_ARRAYSIZE(wtmp_filename))
+        return false;
+    ImTextStrFromUtf8(wfilename, IM_ARRAYSIZE(wfilename), filename, NULL);
+    ImTextStrFromUtf8(wtmp_filename, IM_ARRAYSIZE(wtmp_filename), tmp_filename, NULL);
+    FILE* f = _wfopen((wchar_t*)wtmp_filename, L"wt");
+    if (!f)
+        return false;
+    bool ok = fwrite(data, sizeof(char), data_size, f) == data_size;
+    ok = (fclose(f) == 0) && ok;
+    if (ok)
+        ok = MoveFileExW((wchar_t*)wtmp_filename, (wchar_t*)wfilename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    if (!ok)
+        _wremove((wchar_t*)wtmp_filename);
+    return ok;
+}
+
+#else
+
+static bool ImFileWriteAtomic(const char* filename, const char* tmp_filename, const char* data, size_t data_size)
+{
+    FILE* f = fopen(tmp_filename, "wt");
+    if (!f)
+        return false;
+    bool ok = fwrite(data, sizeof(char), data_size, f) == data_size;
+    ok = (fclose(f) == 0) && ok;
+    if (ok)
+        ok = rename(tmp_filename, filename) == 0;
+    if (!ok)
+        remove(tmp_filename);
+    return ok;
+}
+
+#endif
+
 // Win32 API clipboard implementation
 #if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS)
 
@@ -10973,7 +12105,15 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("ImGui %s", ImGui::GetVersion());
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
+        ImGui::Text("%d draw commands", ImGui::GetIO().MetricsRenderCmds);
+        ImGui::Checkbox("Merge draw commands", &ImGui::GetIO().OptMergeDrawCommands);
+        ImGuiTextSizeCache& text_size_cache = GImGui->TextSizeCache;
+        ImGui::Text("Text size cache: %d/%d entries, %d hits, %d misses", text_size_cache.Entries.Size, ImGui::GetIO().TextSizeCacheCapacity, text_size_cache.HitsLastFrame, text_size_cache.MissesLastFrame);
         ImGui::Text("%d allocations", ImGui::GetIO().MetricsAllocs);
+        if (GImGui->DrawListsTrimFrame >= 0)
+            ImGui::Text("Window draw lists: %d bytes (trimmed from %d to %d bytes on frame %d)", (int)GImGui->DrawListsMemory, (int)GImGui->DrawListsMemoryBeforeTrim, (int)GImGui->DrawListsMemoryAfterTrim, GImGui->DrawListsTrimFrame);
+        else
+            ImGui::Text("Window draw lists: %d bytes", (int)GImGui->DrawListsMemory);
         static bool show_clip_rects = true;
         ImGui::Checkbox("Show clipping rectangles when hovering an ImDrawCmd", &show_clip_rects);
         ImGui::Separator();
@@ -11012,7 +12152,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                         ImRect clip_rect = pcmd->ClipRect;
                         ImRect vtxs_rect;
                         for (int i = elem_offset; i < elem_offset + (int)pcmd->ElemCount; i++)
-                            vtxs_rect.Add(draw_list->VtxBuffer[idx_buffer ? idx_buffer[i] : i].pos);
+                            vtxs_rect.Add(draw_list->VtxBuffer[idx_buffer ? pcmd->VtxOffset + idx_buffer[i] : i].pos);
                         clip_rect.Floor(); overlay_draw_list->AddRect(clip_rect.Min, clip_rect.Max, IM_COL32(255,255,0,255));
                         vtxs_rect.Floor(); overlay_draw_list->AddRect(vtxs_rect.Min, vtxs_rect.Max, IM_COL32(255,0,255,255));
                     }
@@ -11027,7 +12167,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                             ImVec2 triangles_pos[3];
                             for (int n = 0; n < 3; n++, vtx_i++)
                             {
-                                ImDrawVert& v = draw_list->VtxBuffer[idx_buffer ? idx_buffer[vtx_i] : vtx_i];
+                                ImDrawVert& v = draw_list->VtxBuffer[idx_buffer ? pcmd->VtxOffset + idx_buffer[vtx_i] : vtx_i];
                                 triangles_pos[n] = v.pos;
                                 buf_p += ImFormatString(buf_p, (int)(buf_end - buf_p), "%s %04d { pos = (%8.2f,%8.2f), uv = (%.6f,%.6f), col = %08X }\n", (n == 0) ? "vtx" : "   ", vtx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
                             }
@@ -11085,6 +12225,31 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             }
             ImGui::TreePop();
         }
+        if (ImGui::TreeNode("Memory"))
+        {
+            ImGui::Columns(6, "##memtags");
+            ImGui::Text("Tag"); ImGui::NextColumn();
+            ImGui::Text("Live bytes"); ImGui::NextColumn();
+            ImGui::Text("Peak bytes"); ImGui::NextColumn();
+            ImGui::Text("Live allocs"); ImGui::NextColumn();
+            ImGui::Text("Allocs/frame"); ImGui::NextColumn();
+            ImGui::Text("Frees/frame"); ImGui::NextColumn();
+            ImGui::Separator();
+            for (int tag = 0; tag < ImGuiMemTag_Count_; tag++)
+            {
+                ImGuiMemTagStats stats;
+                if (!ImGui::GetMemTagStats(tag, &stats))
+                    break;
+                ImGui::Text("%s", ImGui::GetMemTagName(tag)); ImGui::NextColumn();
+                ImGui::Text("%d", (int)stats.BytesLive); ImGui::NextColumn();
+                ImGui::Text("%d", (int)stats.BytesPeak); ImGui::NextColumn();
+                ImGui::Text("%d", stats.AllocsLive); ImGui::NextColumn();
+                ImGui::Text("%d", stats.AllocsLastFrame); ImGui::NextColumn();
+                ImGui::Text("%d", stats.FreesLastFrame); ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::TreePop();
+        }
         if (ImGui::TreeNode("Basic state"))
         {
             ImGui::Text("HoveredWindow: '%s'", g.HoveredWindow ? g.HoveredWindow->Name : "NULL");
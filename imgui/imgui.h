@@ -64,6 +64,8 @@ struct ImGuiTextBuffer;             // Text buffer for logging/accumulating text
 struct ImGuiTextEditCallbackData;   // Shared state of ImGui::InputText() when using custom ImGuiTextEditCallback (rare/advanced use)
 struct ImGuiSizeConstraintCallbackData;// Structure used to constraint window size in custom ways when using custom ImGuiSizeConstraintCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiPlotMinMax;             // Helper to plot very long series of values, through a min/max pyramid
+struct ImGuiMemTagStats;            // Allocation statistics of a subsystem
 struct ImGuiContext;                // ImGui context (opaque)
 
 // Typedefs and Enumerations (declared as int for compatibility and to not pollute the top of this file)
@@ -76,6 +78,7 @@ typedef int ImGuiStyleVar;          // enum: a variable identifier for styling
 typedef int ImGuiKey;               // enum: a key identifier (ImGui-side enum) // enum ImGuiKey_
 typedef int ImGuiMouseCursor;       // enum: a mouse cursor identifier          // enum ImGuiMouseCursor_
 typedef int ImGuiCond;              // enum: a condition for Set*()             // enum ImGuiCond_
+typedef int ImGuiMemTag;            // enum: a subsystem for allocation stats   // enum ImGuiMemTag_
 typedef int ImDrawCornerFlags;      // flags: corner flags for AddRect*() etc.  // enum ImDrawCornerFlags_
 typedef int ImGuiColorEditFlags;    // flags: color edit flags for Color*()     // enum ImGuiColorEditFlags_
 typedef int ImGuiWindowFlags;       // flags: window flags for Begin*()         // enum ImGuiWindowFlags_
@@ -292,6 +295,8 @@ namespace ImGui
     IMGUI_API void          PlotLines(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
     IMGUI_API void          PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0), int stride = sizeof(float));
     IMGUI_API void          PlotHistogram(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
+    IMGUI_API void          PlotLines(const char* label, const ImGuiPlotMinMax& values, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));      // draw the min/max envelope of the values in each pixel column: the cost depends on the width, not on the number of values
+    IMGUI_API void          PlotHistogram(const char* label, const ImGuiPlotMinMax& values, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0,0));
     IMGUI_API void          ProgressBar(float fraction, const ImVec2& size_arg = ImVec2(-1,0), const char* overlay = NULL);
 
     // Widgets: Drags (tip: ctrl+click on a drag box to input with keyboard. manually input values aren't clamped, can go off-bounds)
@@ -479,6 +484,9 @@ namespace ImGui
     // Helpers functions to access functions pointers in ImGui::GetIO()
     IMGUI_API void*         MemAlloc(size_t sz);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API ImGuiMemTag   SetMemTag(ImGuiMemTag tag);                                         // attribute the next MemAlloc() calls of this thread to a subsystem, returns the previous tag to restore
+    IMGUI_API bool          GetMemTagStats(ImGuiMemTag tag, ImGuiMemTagStats* out_stats);       // allocation statistics of a subsystem (shared by all contexts). false if compiled out with IMGUI_DISABLE_MEM_TAGS
+    IMGUI_API const char*   GetMemTagName(ImGuiMemTag tag);
     IMGUI_API const char*   GetClipboardText();
     IMGUI_API void          SetClipboardText(const char* text);
 
@@ -740,6 +748,20 @@ enum ImGuiMouseCursor_
     ImGuiMouseCursor_Count_
 };
 
+// Subsystems for allocation statistics, see GetMemTagStats(). An allocation made with MemAlloc() is attributed to the tag last set by SetMemTag() on its thread.
+enum ImGuiMemTag_
+{
+    ImGuiMemTag_Other = 0,
+    ImGuiMemTag_DrawList,           // ImDrawList buffers
+    ImGuiMemTag_Window,             // ImGuiWindow, its name and stacks
+    ImGuiMemTag_Storage,            // ImGuiStorage pairs (tree/column state, window lookup, settings index)
+    ImGuiMemTag_FontAtlas,          // ImFontAtlas and ImFont: texture, glyphs, lookup tables
+    ImGuiMemTag_TextBuffer,         // ImGuiTextBuffer, InputText() buffers
+    ImGuiMemTag_DockNode,           // imgui_dock.cpp: Dock objects, labels, tab positions
+    ImGuiMemTag_DockMap,            // imgui_dock.cpp: hash tables of docks
+    ImGuiMemTag_Count_
+};
+
 // Condition for ImGui::SetWindow***(), SetNextWindow***(), SetNextTreeNode***() functions
 // All those functions treat 0 as a shortcut to ImGuiCond_Always. From the point of view of the user use this as an enum (don't combine multiple values into flags).
 enum ImGuiCond_
@@ -791,6 +813,18 @@ struct ImGuiStyle
     IMGUI_API void ScaleAllSizes(float scale_factor);
 };
 
+// Allocation statistics of a subsystem, see GetMemTagStats()
+struct ImGuiMemTagStats
+{
+    size_t      BytesLive;          // Bytes currently allocated
+    size_t      BytesPeak;          // Maximum reached by BytesLive
+    int         AllocsLive;         // Number of allocations currently alive
+    int         AllocsLastFrame;    // MemAlloc() calls during the last frame
+    int         FreesLastFrame;     // MemFree() calls during the last frame
+
+    ImGuiMemTagStats() { memset(this, 0, sizeof(*this)); }
+};
+
 // This is where your app communicate with ImGui. Access via ImGui::GetIO().
 // Read 'Programmer guide' section in .cpp file for general usage.
 struct ImGuiIO
@@ -823,6 +857,9 @@ struct ImGuiIO
     // Advanced/subtle behaviors
     bool          OptMacOSXBehaviors;       // = defined(__APPLE__) // OS X style: Text editing cursor movement using Alt instead of Ctrl, Shortcuts using Cmd/Super instead of Ctrl, Line/Text Start and End using Cmd+Arrows instead of Home/End, Double click selects by word instead of selecting whole text, Multi-selection in lists uses Cmd/Super instead of Ctrl
     bool          OptCursorBlink;           // = true               // Enable blinking cursor, for users who consider it annoying.
+    int           TextSizeCacheCapacity;    // = 4096               // Number of CalcTextSize() results kept in a least recently used cache, so that the same labels are not measured again every frame. 0 to disable.
+    bool          OptMergeDrawCommands;     // = false              // Concatenate the draw lists of all windows in Render() and join consecutive draw commands with the same texture and compatible clipping rectangles, to reduce the number of draw calls. Costs a copy of the vertex and index buffers.
+    int           DrawListShrinkFrames;     // = 600                // Give back the memory of a window draw list that used less than a quarter of its capacity for this many frames (down to 1.5x its peak usage in that time), or whose window was not drawn for this many frames (all of it). Hidden docks free their draw list too. 0 to disable.
 
     //------------------------------------------------------------------
     // Settings (User Functions)
@@ -832,6 +869,7 @@ struct ImGuiIO
     // Alternatively you can keep this to NULL and call GetDrawData() after Render() to get the same pointer.
     // See example applications if you are unsure of how to implement this.
     void        (*RenderDrawListsFn)(ImDrawData* data);
+    bool        RendererHasVtxOffset;       // = false // Set by the rendering binding if it honors ImDrawCmd::VtxOffset. Draw lists then roll over to a new vertex offset instead of overflowing 16-bit indices, so a single window can exceed 64K vertices.
 
     // Optional: access OS clipboard
     // (default to use native Win32 clipboard on Windows, otherwise uses a private clipboard. Override to access OS clipboard on other architectures)
@@ -881,6 +919,7 @@ struct ImGuiIO
     int         MetricsAllocs;              // Number of active memory allocations
     int         MetricsRenderVertices;      // Vertices output during last call to Render()
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderCmds;          // Draw commands output during last call to Render() = number of draw calls (after merging if OptMergeDrawCommands is set)
     int         MetricsActiveWindows;       // Number of visible root windows (exclude child windows)
     ImVec2      MouseDelta;                 // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
@@ -980,6 +1019,17 @@ public:
         Data = new_data;
         Capacity = new_capacity;
     }
+    inline void                 shrink_to(int new_capacity)     // Reduce the capacity, never below the current size
+    {
+        if (new_capacity < Size) new_capacity = Size;
+        if (new_capacity >= Capacity) return;
+        T* new_data = new_capacity ? (value_type*)ImGui::MemAlloc((size_t)new_capacity * sizeof(T)) : NULL;
+        if (new_data && Size)
+            memcpy(new_data, Data, (size_t)Size * sizeof(T));
+        ImGui::MemFree(Data);
+        Data = new_data;
+        Capacity = new_capacity;
+    }
 
     inline void                 push_back(const value_type& v)  { if (Size == Capacity) reserve(_grow_capacity(Size+1)); Data[Size++] = v; }
     inline void                 pop_back()                      { IM_ASSERT(Size > 0); Size--; }
@@ -1073,12 +1123,29 @@ struct ImGuiStorage
         Pair(ImGuiID _key, float _val_f) { key = _key; val_f = _val_f; }
         Pair(ImGuiID _key, void* _val_p) { key = _key; val_p = _val_p; }
     };
-    ImVector<Pair>      Data;
+    ImVector<Pair>      Data;               // Pairs sorted by key. With UseHashTable: the slots of the hash table (key 0 = free slot)
+    bool                UseHashTable;       // Store the pairs in an open-addressing hash table instead of a sorted vector. Change with SetUseHashTable(). Defaults to false, or true if IMGUI_STORAGE_USE_HASH_TABLE is defined.
+    int                 HashCount;          // Number of used slots in the hash table
+    bool                HashHasZeroKey;     // The pair with key 0 is stored in HashZeroKeyPair, as key 0 marks free slots
+    Pair                HashZeroKeyPair;
+
+    ImGuiStorage() : HashZeroKeyPair(0, (void*)NULL)
+    {
+#ifdef IMGUI_STORAGE_USE_HASH_TABLE
+        UseHashTable = true;
+#else
+        UseHashTable = false;
+#endif
+        HashCount = 0;
+        HashHasZeroKey = false;
+    }
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N), or O(1) with UseHashTable.
     // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Sorted insertion is costly (O(N) memmove), paid once. A typical frame shouldn't need to insert any new pair. Storages with thousands of keys that
+    //   change often (large trees) should use the hash table, where insertion is O(1). It uses ~4/3 the memory and does not keep the pairs ordered.
+    IMGUI_API void      Clear();
+    IMGUI_API void      SetUseHashTable(bool use_hash_table);   // Convert the existing pairs
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -1100,7 +1167,7 @@ struct ImGuiStorage
     // Use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
-    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once. No-op with UseHashTable.
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -1212,6 +1279,31 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Helper: Min/max pyramid of a long series of values, for PlotLines()/PlotHistogram().
+// Plotting 10^7 values with a getter either skips most of them (losing the spikes) or reads all of them every frame. Instead, keep the values here:
+// level k of the pyramid holds the (min,max) of each block of 4^(k+1) consecutive values, so the exact min/max of any range is found in O(log n)
+// and the plot draws the envelope of each pixel column. The pyramid takes about 2/3 of the memory of the values. Append() only updates the blocks
+// that contain the new values.
+//     static ImGuiPlotMinMax trace;
+//     trace.Append(values, count);   // once, or as new values arrive
+//     ImGui::PlotLines("Energy", trace);
+struct ImGuiPlotMinMax
+{
+    enum { MaxLevels = 15 };                // blocks of up to 4^15 values
+
+    ImVector<float>     Values;             // The values
+    ImVector<ImVec2>    Levels[MaxLevels];  // Levels[k][i] = (min,max) of Values[i*4^(k+1) .. (i+1)*4^(k+1)-1] (the last block may be partial)
+    int                 LevelsCount;        // Number of levels in use (4^LevelsCount <= Values.Size)
+
+    ImGuiPlotMinMax()                       { LevelsCount = 0; }
+    int                 Size() const        { return Values.Size; }
+    IMGUI_API void      Clear();
+    IMGUI_API void      Build(const float* values, int count, int stride = sizeof(float));     // Replace the values and build the pyramid
+    IMGUI_API void      Append(const float* values, int count, int stride = sizeof(float));    // Append values, updating the pyramid
+    void                Append(float value)                     { Append(&value, 1); }
+    IMGUI_API ImVec2    GetMinMax(int idx_begin, int idx_end) const;                           // Exact (min,max) of Values[idx_begin..idx_end-1], in O(log n)
+};
+
 //-----------------------------------------------------------------------------
 // Draw List
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -1231,8 +1323,9 @@ struct ImDrawCmd
     ImTextureID     TextureId;              // User-provided texture ID. Set by user in ImfontAtlas::SetTexID() for fonts or passed to Image*() functions. Ignore if never using images or multiple fonts atlas.
     ImDrawCallback  UserCallback;           // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;       // The draw callback code can access this.
+    unsigned int    VtxOffset;              // Start offset in vertex buffer: the indices of this command refer to vtx_buffer[VtxOffset + idx]. Always 0 unless io.RendererHasVtxOffset is set and the draw list went over 64K vertices.
 
-    ImDrawCmd() { ElemCount = 0; ClipRect.x = ClipRect.y = -8192.0f; ClipRect.z = ClipRect.w = +8192.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; }
+    ImDrawCmd() { ElemCount = 0; ClipRect.x = ClipRect.y = -8192.0f; ClipRect.z = ClipRect.w = +8192.0f; TextureId = NULL; UserCallback = NULL; UserCallbackData = NULL; VtxOffset = 0; }
 };
 
 // Vertex index (override with '#define ImDrawIdx unsigned int' inside in imconfig.h)
@@ -1293,7 +1386,9 @@ struct ImDrawList
 
     // [Internal, used while building lists]
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
-    unsigned int            _VtxCurrentIdx;     // [Internal] == VtxBuffer.Size
+    unsigned int            _VtxCurrentIdx;     // [Internal] == VtxBuffer.Size - _VtxCurrentOffset
+    unsigned int            _VtxCurrentOffset;  // [Internal] VtxOffset of the commands being appended
+    bool                    _AllowVtxOffset;    // [Internal] start a new VtxOffset instead of overflowing 16-bit indices (set from io.RendererHasVtxOffset)
     ImDrawVert*             _VtxWritePtr;       // [Internal] point within VtxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImDrawIdx*              _IdxWritePtr;       // [Internal] point within IdxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImVector<ImVec4>        _ClipRectStack;     // [Internal]
@@ -1302,8 +1397,10 @@ struct ImDrawList
     int                     _ChannelsCurrent;   // [Internal] current channel number (0)
     int                     _ChannelsCount;     // [Internal] number of active channels (1+)
     ImVector<ImDrawChannel> _Channels;          // [Internal] draw channels for columns API (not resized down so _ChannelsCount may be smaller than _Channels.Size)
+    int                     _ShrinkFrames;      // [Internal] number of frames in a row the buffers used less than a quarter of their capacity (see io.DrawListShrinkFrames)
+    int                     _ShrinkPeakCmd, _ShrinkPeakIdx, _ShrinkPeakVtx; // [Internal] peak usage of the buffers during those frames
 
-    ImDrawList()  { _OwnerName = NULL; Clear(); }
+    ImDrawList()  { _OwnerName = NULL; _AllowVtxOffset = false; _ShrinkFrames = _ShrinkPeakCmd = _ShrinkPeakIdx = _ShrinkPeakVtx = 0; Clear(); }
     ~ImDrawList() { ClearFreeMemory(); }
     IMGUI_API void  PushClipRect(ImVec2 clip_rect_min, ImVec2 clip_rect_max, bool intersect_with_current_clip_rect = false);  // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
     IMGUI_API void  PushClipRectFullScreen();
@@ -1359,6 +1456,8 @@ struct ImDrawList
     // NB: all primitives needs to be reserved via PrimReserve() beforehand!
     IMGUI_API void  Clear();
     IMGUI_API void  ClearFreeMemory();
+    IMGUI_API void  ShrinkBuffers(int cmd_capacity, int idx_capacity, int vtx_capacity); // Reduce the capacity of the buffers (never below their size) and free the extra channels. Call between frames.
+    IMGUI_API size_t GetMemoryUsage() const;                                    // Bytes allocated by the buffers, stacks and channels
     IMGUI_API void  PrimReserve(int idx_count, int vtx_count);
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
@@ -1397,6 +1496,7 @@ struct ImFontConfig
     ImVec2          GlyphExtraSpacing;          // 0, 0     // Extra spacing (in pixels) between glyphs. Only X axis is supported for now.
     ImVec2          GlyphOffset;                // 0, 0     // Offset all glyphs from this font input.
     const ImWchar*  GlyphRanges;                // NULL     // Pointer to a user-provided list of Unicode range (2 value per range, values are inclusive, zero-terminated list). THE ARRAY DATA NEEDS TO PERSIST AS LONG AS THE FONT IS ALIVE.
+    const ImWchar*  GlyphRangesDynamic;         // NULL     // Unicode ranges (same format as GlyphRanges) whose glyphs are not baked by Build() but rasterized on demand, the first time FindGlyph() is asked for them. Requires the TTF data and the atlas pixels to be kept (no ClearInputData()/ClearTexData()). THE ARRAY DATA NEEDS TO PERSIST AS LONG AS THE FONT IS ALIVE.
     bool            MergeMode;                  // false    // Merge into previous ImFont, so you can combine multiple inputs font into one ImFont (e.g. ASCII font + icons + Japanese glyphs). You may want to use GlyphOffset.y when merge font of different heights.
     unsigned int    RasterizerFlags;            // 0x00     // Settings for custom font rasterizer (e.g. ImGuiFreeType). Leave as zero if you aren't using one.
     float           RasterizerMultiply;         // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable.
@@ -1408,6 +1508,8 @@ struct ImFontConfig
     IMGUI_API ImFontConfig();
 };
 
+struct ImFontAtlasDynamicGlyphs;    // Packing and request state for the glyphs loaded on demand (defined in imgui_draw.cpp)
+
 struct ImFontGlyph
 {
     ImWchar         Codepoint;          // 0x0000..0xFFFF
@@ -1448,6 +1550,11 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Glyphs loaded on demand (ImFontConfig::GlyphRangesDynamic) are packed below the baked glyphs, in an area of DynamicTexHeight pixels.
+    // UpdateDynamicGlyphs() rasterizes the glyphs requested in the previous frame. It is called by NewFrame(). When the area is full, the glyphs not used in the
+    // previous frame are evicted and the others are moved. The parts of the texture that changed are added to TexDirtyRects: the renderer uploads them again and clears the list.
+    IMGUI_API bool              UpdateDynamicGlyphs();      // Returns true if the texture changed
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -1504,6 +1611,9 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1.
+    const char*                 CacheFilename;      // Path to a file where Build() saves the baked atlas and its glyphs. Next time, if the fonts and settings are unchanged, Build() loads it instead of rasterizing again. Defaults to NULL (no cache).
+    int                         DynamicTexHeight;   // Height in pixels of the texture area reserved for glyphs loaded on demand, when a font uses ImFontConfig::GlyphRangesDynamic. This caps their texture memory. Defaults to 512.
+    int                         BuildThreadsCount;  // Number of threads rasterizing glyphs in Build(). 0 = one per core, 1 = calling thread only. The atlas is identical in all cases. With more than one thread, io.MemAllocFn/MemFreeFn must be thread-safe. Defaults to 0.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -1516,6 +1626,11 @@ struct ImFontAtlas
     ImVector<CustomRect>        CustomRects;        // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Internal data
     int                         CustomRectIds[1];   // Identifiers of custom texture rectangle used by ImFontAtlas/ImDrawList
+    struct DirtyRect            { int X, Y, Width, Height; };
+    ImVector<DirtyRect>         TexDirtyRects;      // Texture areas changed by UpdateDynamicGlyphs() since the renderer last cleared this list
+    int                         TexDynamicY;        // Top of the texture area where glyphs loaded on demand are packed
+    ImFontAtlasDynamicGlyphs*   DynamicGlyphs;      // NULL when no font uses ImFontConfig::GlyphRangesDynamic
+    int                         Generation;         // Incremented when fonts are cleared or their glyphs change, so that cached text measurements can be discarded
 };
 
 // Font runtime data and rendering
@@ -1539,6 +1654,8 @@ struct ImFont
     ImFontAtlas*                ContainerAtlas;     //              // What we has been loaded into
     float                       Ascent, Descent;    //              // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;//              // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
+    int                         DynamicGlyphsStart; //              // Index in Glyphs of the first glyph loaded on demand. The glyphs before it were baked by Build().
+    mutable ImVector<int>       DynamicGlyphsLastUsed; //           // Frame in which FindGlyph() last returned each glyph loaded on demand, so that the unused ones can be evicted
 
     // Methods
     IMGUI_API ImFont();
@@ -1552,10 +1669,11 @@ struct ImFont
 
     // 'max_width' stops rendering after a certain width (could be turned into a 2d size). FLT_MAX to disable.
     // 'wrap_width' enable automatic word-wrapping across multiple lines to fit into given width. 0.0f to disable.
-    IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL) const; // utf8
+    // 'out_wrap_eols' receives the offsets of the ends of the word-wrapped lines, which can be passed back as 'wrap_eols' to RenderText() with the same text, size and wrap_width to skip searching them again.
+    IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL, ImVector<int>* out_wrap_eols = NULL) const; // utf8
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, unsigned short c) const;
-    IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
+    IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false, const int* wrap_eols = NULL) const;
 
     // [Internal]
     IMGUI_API void              GrowIndex(int new_size);
@@ -19,6 +19,11 @@
 #include "imgui_internal.h"
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+#include <thread>       // std::thread
+#include <atomic>       // std::atomic
+#include <mutex>        // std::mutex
+#endif
 #if !defined(alloca)
 #ifdef _WIN32
 #include <malloc.h>     // alloca
@@ -89,8 +94,10 @@ namespace IMGUI_STB_NAMESPACE
 #endif
 #include "stb_rect_pack.h"
 
-#define STBTT_malloc(x,u)  ((void)(u), ImGui::MemAlloc(x))
-#define STBTT_free(x,u)    ((void)(u), ImGui::MemFree(x))
+// stb_truetype allocations are freed before ImFontAtlas::Build() returns and are made from the font build threads too,
+// so they go straight to the allocator and skip io.MetricsAllocs and its lock.
+#define STBTT_malloc(x,u)  ((void)(u), GImGui->IO.MemAllocFn(x))
+#define STBTT_free(x,u)    ((void)(u), GImGui->IO.MemFreeFn(x))
 #define STBTT_assert(x)    IM_ASSERT(x)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 #define STBTT_STATIC
@@ -283,6 +290,7 @@ void ImDrawList::Clear()
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
     _VtxCurrentIdx = 0;
+    _VtxCurrentOffset = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
     _ClipRectStack.resize(0);
@@ -299,6 +307,7 @@ void ImDrawList::ClearFreeMemory()
     IdxBuffer.clear();
     VtxBuffer.clear();
     _VtxCurrentIdx = 0;
+    _VtxCurrentOffset = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
     _ClipRectStack.clear();
@@ -313,6 +322,35 @@ void ImDrawList::ClearFreeMemory()
         _Channels[i].IdxBuffer.clear();
     }
     _Channels.clear();
+    _ShrinkFrames = _ShrinkPeakCmd = _ShrinkPeakIdx = _ShrinkPeakVtx = 0;
+}
+
+void ImDrawList::ShrinkBuffers(int cmd_capacity, int idx_capacity, int vtx_capacity)
+{
+    IM_ASSERT(_ChannelsCount == 1);
+    CmdBuffer.shrink_to(cmd_capacity);
+    IdxBuffer.shrink_to(idx_capacity);
+    VtxBuffer.shrink_to(vtx_capacity);
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+    _Path.shrink_to(0);
+
+    // Channel 0 shares its buffers with CmdBuffer/IdxBuffer after a merge, the others are allocated again by ChannelsSplit() when needed
+    for (int i = 1; i < _Channels.Size; i++)
+    {
+        _Channels[i].CmdBuffer.clear();
+        _Channels[i].IdxBuffer.clear();
+    }
+}
+
+size_t ImDrawList::GetMemoryUsage() const
+{
+    size_t sz = (size_t)CmdBuffer.Capacity * sizeof(ImDrawCmd) + (size_t)IdxBuffer.Capacity * sizeof(ImDrawIdx) + (size_t)VtxBuffer.Capacity * sizeof(ImDrawVert);
+    sz += (size_t)_ClipRectStack.Capacity * sizeof(ImVec4) + (size_t)_TextureIdStack.Capacity * sizeof(ImTextureID) + (size_t)_Path.Capacity * sizeof(ImVec2);
+    sz += (size_t)_Channels.Capacity * sizeof(ImDrawChannel);
+    for (int i = 1; i < _Channels.Size; i++)
+        sz += (size_t)_Channels[i].CmdBuffer.Capacity * sizeof(ImDrawCmd) + (size_t)_Channels[i].IdxBuffer.Capacity * sizeof(ImDrawIdx);
+    return sz;
 }
 
 // Using macros because C++ is a terrible language, we want guaranteed inline, no code in header, and no overhead in Debug builds
@@ -321,9 +359,11 @@ void ImDrawList::ClearFreeMemory()
 
 void ImDrawList::AddDrawCmd()
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DrawList);
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = GetCurrentClipRect();
     draw_cmd.TextureId = GetCurrentTextureId();
+    draw_cmd.VtxOffset = _VtxCurrentOffset;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -358,7 +398,7 @@ void ImDrawList::UpdateClipRect()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (curr_cmd->ElemCount == 0 && prev_cmd && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == GetCurrentTextureId() && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && prev_cmd && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == GetCurrentTextureId() && prev_cmd->VtxOffset == _VtxCurrentOffset && prev_cmd->UserCallback == NULL)
         CmdBuffer.pop_back();
     else
         curr_cmd->ClipRect = curr_clip_rect;
@@ -377,7 +417,7 @@ void ImDrawList::UpdateTextureID()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->VtxOffset == _VtxCurrentOffset && prev_cmd->UserCallback == NULL)
         CmdBuffer.pop_back();
     else
         curr_cmd->TextureId = curr_texture_id;
@@ -389,6 +429,7 @@ void ImDrawList::UpdateTextureID()
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_current_clip_rect)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DrawList);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect && _ClipRectStack.Size)
     {
@@ -420,6 +461,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(const ImTextureID& texture_id)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DrawList);
     _TextureIdStack.push_back(texture_id);
     UpdateTextureID();
 }
@@ -433,6 +475,7 @@ void ImDrawList::PopTextureID()
 
 void ImDrawList::ChannelsSplit(int channels_count)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DrawList);
     IM_ASSERT(_ChannelsCurrent == 0 && _ChannelsCount == 1);
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -459,6 +502,7 @@ void ImDrawList::ChannelsSplit(int channels_count)
             ImDrawCmd draw_cmd;
             draw_cmd.ClipRect = _ClipRectStack.back();
             draw_cmd.TextureId = _TextureIdStack.back();
+            draw_cmd.VtxOffset = _VtxCurrentOffset;
             _Channels[i].CmdBuffer.push_back(draw_cmd);
         }
     }
@@ -466,6 +510,7 @@ void ImDrawList::ChannelsSplit(int channels_count)
 
 void ImDrawList::ChannelsMerge()
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DrawList);
     // Note that we never use or rely on channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_ChannelsCount <= 1)
         return;
@@ -508,21 +553,50 @@ void ImDrawList::ChannelsSetCurrent(int idx)
     memcpy(&CmdBuffer, &_Channels.Data[_ChannelsCurrent].CmdBuffer, sizeof(CmdBuffer));
     memcpy(&IdxBuffer, &_Channels.Data[_ChannelsCurrent].IdxBuffer, sizeof(IdxBuffer));
     _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+
+    // Another channel may have rolled over to a new vertex offset since this one was last used
+    ImDrawCmd* curr_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
+    if (curr_cmd && curr_cmd->VtxOffset != _VtxCurrentOffset)
+    {
+        if (curr_cmd->ElemCount == 0 && curr_cmd->UserCallback == NULL)
+            curr_cmd->VtxOffset = _VtxCurrentOffset;
+        else
+            AddDrawCmd();
+    }
 }
 
 // NB: this can be called with negative count for removing primitives (as long as the result does not underflow)
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    // With 16-bit indices, start a new vertex offset (and command) when the current one is full. The renderer must honor ImDrawCmd::VtxOffset.
+    if (sizeof(ImDrawIdx) == 2 && _AllowVtxOffset && _VtxCurrentIdx + vtx_count >= (1 << 16))
+    {
+        _VtxCurrentOffset = VtxBuffer.Size;
+        _VtxCurrentIdx = 0;
+        ImDrawCmd& curr_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
+        if (curr_cmd.ElemCount == 0 && curr_cmd.UserCallback == NULL)
+            curr_cmd.VtxOffset = _VtxCurrentOffset;
+        else
+            AddDrawCmd();
+    }
+
     ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
     draw_cmd.ElemCount += idx_count;
 
+    // Only set the allocation tag when the buffers grow, this is called for every primitive
     int vtx_buffer_old_size = VtxBuffer.Size;
+    int idx_buffer_old_size = IdxBuffer.Size;
+    const bool grow = vtx_buffer_old_size + vtx_count > VtxBuffer.Capacity || idx_buffer_old_size + idx_count > IdxBuffer.Capacity;
+    const ImGuiMemTag backup_mem_tag = grow ? ImGui::SetMemTag(ImGuiMemTag_DrawList) : ImGuiMemTag_Other;
+
     VtxBuffer.resize(vtx_buffer_old_size + vtx_count);
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_old_size;
 
-    int idx_buffer_old_size = IdxBuffer.Size;
     IdxBuffer.resize(idx_buffer_old_size + idx_count);
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_old_size;
+
+    if (grow)
+        ImGui::SetMemTag(backup_mem_tag);
 }
 
 // Fully unrolled with inline call to keep our debug builds decently fast.
@@ -570,6 +644,98 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
     _IdxWritePtr += 6;
 }
 
+// Normals of the segments points[i] -> points[i+1] (points[0] after the last point), for i < count.
+// The SSE2 path does two segments at a time with the same operations as the scalar path, so the results are identical.
+static void ComputeSegmentNormals(const ImVec2* points, const int points_count, const int count, ImVec2* out_normals)
+{
+    int i = 0;
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign_y = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, (int)0x80000000, 0));
+    for (; i + 2 < points_count && i + 1 < count; i += 2)
+    {
+        __m128 diff = _mm_sub_ps(_mm_loadu_ps(&points[i+1].x), _mm_loadu_ps(&points[i].x));          // dx0 dy0 dx1 dy1
+        __m128 sq = _mm_mul_ps(diff, diff);
+        __m128 d = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2,3,0,1)));                      // dx*dx + dy*dy in both lanes of each point
+        __m128 valid = _mm_cmpgt_ps(d, _mm_setzero_ps());
+        __m128 inv_length = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(one, _mm_sqrt_ps(d))), _mm_andnot_ps(valid, one));
+        diff = _mm_mul_ps(diff, inv_length);
+        _mm_storeu_ps(&out_normals[i].x, _mm_xor_ps(_mm_shuffle_ps(diff, diff, _MM_SHUFFLE(2,3,0,1)), sign_y)); // (dy, -dx)
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const int i2 = (i+1) == points_count ? 0 : i+1;
+        ImVec2 diff = points[i2] - points[i];
+        diff *= ImInvLength(diff, 1.0f);
+        out_normals[i].x = diff.y;
+        out_normals[i].y = -diff.x;
+    }
+}
+
+// Averaged normals at the joints between segment i1 and segment i2 = i1+1 (0 after the last point), for i1 < count, stored in out_dm[i2].
+// They are scaled by the inverse of their squared length so the fringe keeps its width at sharp corners (clamped to 100).
+static void ComputeJointNormals(const ImVec2* normals, const int points_count, const int count, ImVec2* out_dm)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f), min_dmr2 = _mm_set1_ps(0.000001f), max_scale = _mm_set1_ps(100.0f);
+    for (; i1 + 2 < points_count && i1 + 1 < count; i1 += 2)
+    {
+        __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i1].x), _mm_loadu_ps(&normals[i1+1].x)), half);
+        __m128 sq = _mm_mul_ps(dm, dm);
+        __m128 dmr2 = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2,3,0,1)));
+        __m128 scaled = _mm_mul_ps(dm, _mm_min_ps(_mm_div_ps(one, dmr2), max_scale));
+        __m128 valid = _mm_cmpgt_ps(dmr2, min_dmr2);
+        _mm_storeu_ps(&out_dm[i1+1].x, _mm_or_ps(_mm_and_ps(valid, scaled), _mm_andnot_ps(valid, dm)));
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1+1) == points_count ? 0 : i1+1;
+        ImVec2 dm = (normals[i1] + normals[i2]) * 0.5f;
+        float dmr2 = dm.x*dm.x + dm.y*dm.y;
+        if (dmr2 > 0.000001f)
+        {
+            float scale = 1.0f / dmr2;
+            if (scale > 100.0f) scale = 100.0f;
+            dm *= scale;
+        }
+        out_dm[i2] = dm;
+    }
+}
+
+// Write 'count' blocks of indices, block b being base + pattern[k] + b * step. Returns the new write pointer.
+// With 16-bit indices the SSE2 path writes eight blocks per iteration.
+template<int N>
+static inline ImDrawIdx* WriteIndexBlocks(ImDrawIdx* out, unsigned int base, const unsigned int (&pattern)[N], const unsigned int step, const int count)
+{
+    int b = 0;
+#ifdef IMGUI_ENABLE_SSE2
+    if (sizeof(ImDrawIdx) == 2 && count >= 16)
+    {
+        unsigned short vals[8*N];
+        for (int bb = 0, e = 0; bb < 8; bb++)
+            for (int k = 0; k < N; k++, e++)
+                vals[e] = (unsigned short)(base + pattern[k] + bb * step);
+        __m128i vals_v[N];
+        for (int j = 0; j < N; j++)
+            vals_v[j] = _mm_loadu_si128((const __m128i*)(vals + j * 8));
+        const __m128i inc = _mm_set1_epi16((short)(8 * step));
+        for (; b + 8 <= count; b += 8, out += 8 * N, base += 8 * step)
+            for (int j = 0; j < N; j++)
+            {
+                _mm_storeu_si128((__m128i*)(out + j * 8), vals_v[j]);
+                vals_v[j] = _mm_add_epi16(vals_v[j], inc);
+            }
+    }
+#endif
+    for (; b < count; b++, out += N, base += step)
+        for (int k = 0; k < N; k++)
+            out[k] = (ImDrawIdx)(base + pattern[k]);
+    return out;
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness, bool anti_aliased)
 {
@@ -596,108 +762,53 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2));
-        ImVec2* temp_points = temp_normals + points_count;
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * 2 * sizeof(ImVec2));
+        ImVec2* temp_joints = temp_normals + points_count;
 
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1+1) == points_count ? 0 : i1+1;
-            ImVec2 diff = points[i2] - points[i1];
-            diff *= ImInvLength(diff, 1.0f);
-            temp_normals[i1].x = diff.y;
-            temp_normals[i1].y = -diff.x;
-        }
+        ComputeSegmentNormals(points, points_count, count, temp_normals);
         if (!closed)
             temp_normals[points_count-1] = temp_normals[points_count-2];
+        ComputeJointNormals(temp_normals, points_count, count, temp_joints);
+        if (!closed)
+            temp_joints[0] = temp_normals[0];
+
+        // Segments that do not wrap around share their vertices with the next one
+        const int count_linked = (count == points_count) ? count-1 : count;
 
         if (!thick_line)
         {
-            if (!closed)
+            // Add indexes
+            static const unsigned int pattern[12] = { 3,0,2, 2,5,3, 4,1,0, 0,3,4 };
+            _IdxWritePtr = WriteIndexBlocks(_IdxWritePtr, _VtxCurrentIdx, pattern, 3, count_linked);
+            if (count_linked < count)
             {
-                temp_points[0] = points[0] + temp_normals[0] * AA_SIZE;
-                temp_points[1] = points[0] - temp_normals[0] * AA_SIZE;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * AA_SIZE;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * AA_SIZE;
-            }
-
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx;
-            for (int i1 = 0; i1 < count; i1++)
-            {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
-                unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+3;
-
-                // Average normals
-                ImVec2 dm = (temp_normals[i1] + temp_normals[i2]) * 0.5f;
-                float dmr2 = dm.x*dm.x + dm.y*dm.y;
-                if (dmr2 > 0.000001f)
-                {
-                    float scale = 1.0f / dmr2;
-                    if (scale > 100.0f) scale = 100.0f;
-                    dm *= scale;
-                }
-                dm *= AA_SIZE;
-                temp_points[i2*2+0] = points[i2] + dm;
-                temp_points[i2*2+1] = points[i2] - dm;
-
-                // Add indexes
+                const unsigned int idx1 = _VtxCurrentIdx + count_linked*3, idx2 = _VtxCurrentIdx;
                 _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
                 _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
                 _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
                 _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
                 _IdxWritePtr += 12;
-
-                idx1 = idx2;
             }
 
             // Add vertexes
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-                _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
-                _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
+                const ImVec2 dm = temp_joints[i] * AA_SIZE;
+                _VtxWritePtr[0].pos = points[i];      _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                _VtxWritePtr[1].pos = points[i] + dm; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
+                _VtxWritePtr[2].pos = points[i] - dm; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
                 _VtxWritePtr += 3;
             }
         }
         else
         {
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+0] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+1] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+2] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+3] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
-            }
-
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx;
-            for (int i1 = 0; i1 < count; i1++)
+            // Add indexes
+            static const unsigned int pattern[18] = { 5,1,2, 2,6,5, 5,1,0, 0,4,5, 6,2,3, 3,7,6 };
+            _IdxWritePtr = WriteIndexBlocks(_IdxWritePtr, _VtxCurrentIdx, pattern, 4, count_linked);
+            if (count_linked < count)
             {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
-                unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+4;
-
-                // Average normals
-                ImVec2 dm = (temp_normals[i1] + temp_normals[i2]) * 0.5f;
-                float dmr2 = dm.x*dm.x + dm.y*dm.y;
-                if (dmr2 > 0.000001f)
-                {
-                    float scale = 1.0f / dmr2;
-                    if (scale > 100.0f) scale = 100.0f;
-                    dm *= scale;
-                }
-                ImVec2 dm_out = dm * (half_inner_thickness + AA_SIZE);
-                ImVec2 dm_in = dm * half_inner_thickness;
-                temp_points[i2*4+0] = points[i2] + dm_out;
-                temp_points[i2*4+1] = points[i2] + dm_in;
-                temp_points[i2*4+2] = points[i2] - dm_in;
-                temp_points[i2*4+3] = points[i2] - dm_out;
-
-                // Add indexes
+                const unsigned int idx1 = _VtxCurrentIdx + count_linked*4, idx2 = _VtxCurrentIdx;
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1+2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1+2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2+2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2+1);
                 _IdxWritePtr[6]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1+0);
@@ -705,17 +816,17 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 _IdxWritePtr[12] = (ImDrawIdx)(idx2+2); _IdxWritePtr[13] = (ImDrawIdx)(idx1+2); _IdxWritePtr[14] = (ImDrawIdx)(idx1+3);
                 _IdxWritePtr[15] = (ImDrawIdx)(idx1+3); _IdxWritePtr[16] = (ImDrawIdx)(idx2+3); _IdxWritePtr[17] = (ImDrawIdx)(idx2+2);
                 _IdxWritePtr += 18;
-
-                idx1 = idx2;
             }
 
             // Add vertexes
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i*4+0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i*4+1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i*4+2]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i*4+3]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
+                const ImVec2 dm_out = temp_joints[i] * (half_inner_thickness + AA_SIZE);
+                const ImVec2 dm_in = temp_joints[i] * half_inner_thickness;
+                _VtxWritePtr[0].pos = points[i] + dm_out; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
+                _VtxWritePtr[1].pos = points[i] + dm_in;  _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos = points[i] - dm_in;  _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos = points[i] - dm_out; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
                 _VtxWritePtr += 4;
             }
         }
@@ -728,6 +839,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const int vtx_count = count*4;      // FIXME-OPT: Not sharing edges
         PrimReserve(idx_count, vtx_count);
 
+        // Scalar only: the SSE2 normals and index blocks measured no faster here
         for (int i1 = 0; i1 < count; i1++)
         {
             const int i2 = (i1+1) == points_count ? 0 : i1+1;
@@ -776,42 +888,73 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2));
-        for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+#ifdef IMGUI_ENABLE_SSE2
+        // The SSE2 normals and index blocks only pay off for large polygons (drawbench: faster from ~128 points, slower below ~32)
+        if (points_count >= 128)
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            ImVec2 diff = p1 - p0;
-            diff *= ImInvLength(diff, 1.0f);
-            temp_normals[i0].x = diff.y;
-            temp_normals[i0].y = -diff.x;
-        }
+            // Compute normals
+            ImVec2* temp_normals = (ImVec2*)alloca(points_count * 2 * sizeof(ImVec2));
+            ImVec2* temp_joints = temp_normals + points_count;
+            ComputeSegmentNormals(points, points_count, points_count, temp_normals);
+            ComputeJointNormals(temp_normals, points_count, points_count, temp_joints);
+
+            // Add vertices
+            for (int i = 0; i < points_count; i++)
+            {
+                const ImVec2 dm = temp_joints[i] * (AA_SIZE * 0.5f);
+                _VtxWritePtr[0].pos = (points[i] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+                _VtxWritePtr[1].pos = (points[i] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+                _VtxWritePtr += 2;
+            }
 
-        for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+            // Add indexes for fringes, the first one closing the polygon
+            const int i0 = points_count-1;
+            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
+            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx);
+            _IdxWritePtr += 6;
+            static const unsigned int fringe_pattern[6] = { 2,0,1, 1,3,2 };
+            _IdxWritePtr = WriteIndexBlocks(_IdxWritePtr, vtx_inner_idx, fringe_pattern, 2, points_count-1);
+        }
+        else
+#endif
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            ImVec2 dm = (n0 + n1) * 0.5f;
-            float dmr2 = dm.x*dm.x + dm.y*dm.y;
-            if (dmr2 > 0.000001f)
+            // Compute normals
+            ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2));
+            for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
             {
-                float scale = 1.0f / dmr2;
-                if (scale > 100.0f) scale = 100.0f;
-                dm *= scale;
+                const ImVec2& p0 = points[i0];
+                const ImVec2& p1 = points[i1];
+                ImVec2 diff = p1 - p0;
+                diff *= ImInvLength(diff, 1.0f);
+                temp_normals[i0].x = diff.y;
+                temp_normals[i0].y = -diff.x;
             }
-            dm *= AA_SIZE * 0.5f;
 
-            // Add vertices
-            _VtxWritePtr[0].pos = (points[i1] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos = (points[i1] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
+            for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+            {
+                // Average normals
+                const ImVec2& n0 = temp_normals[i0];
+                const ImVec2& n1 = temp_normals[i1];
+                ImVec2 dm = (n0 + n1) * 0.5f;
+                float dmr2 = dm.x*dm.x + dm.y*dm.y;
+                if (dmr2 > 0.000001f)
+                {
+                    float scale = 1.0f / dmr2;
+                    if (scale > 100.0f) scale = 100.0f;
+                    dm *= scale;
+                }
+                dm *= AA_SIZE * 0.5f;
 
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
-            _IdxWritePtr += 6;
+                // Add vertices
+                _VtxWritePtr[0].pos = (points[i1] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+                _VtxWritePtr[1].pos = (points[i1] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+                _VtxWritePtr += 2;
+
+                // Add indexes for fringes
+                _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
+                _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
+                _IdxWritePtr += 6;
+            }
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
@@ -835,22 +978,60 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     }
 }
 
-void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int a_min_of_12, int a_max_of_12)
+// Precomputed points on the unit circle, so that PathArcToFast(), AddCircle() and AddCircleFilled() don't evaluate cosf()/sinf() per segment.
+// The tables are filled by a static constructor, not on first use, so that draw lists can be built from several threads at once.
+#define IM_DRAWLIST_CIRCLE_TABLE_MAX    64  // Largest segment count of AddCircle()/AddCircleFilled() served from the tables
+struct ImDrawListCircleTables
 {
-    static ImVec2 circle_vtx[12];
-    static bool circle_vtx_builds = false;
-    const int circle_vtx_count = IM_ARRAYSIZE(circle_vtx);
-    if (!circle_vtx_builds)
+    ImVec2  Arc12[12];                                  // 12 steps around the circle, for PathArcToFast()
+    ImVec2  Circles[(IM_DRAWLIST_CIRCLE_TABLE_MAX + 1) * (IM_DRAWLIST_CIRCLE_TABLE_MAX + 2) / 2];
+    int     CirclesOffset[IM_DRAWLIST_CIRCLE_TABLE_MAX + 1]; // The num_segments+1 points of a circle with num_segments segments start at Circles[CirclesOffset[num_segments]]
+
+    ImDrawListCircleTables()
     {
-        for (int i = 0; i < circle_vtx_count; i++)
+        const int arc12_count = IM_ARRAYSIZE(Arc12);
+        for (int i = 0; i < arc12_count; i++)
+        {
+            const float a = ((float)i / (float)arc12_count) * 2*IM_PI;
+            Arc12[i] = ImVec2(cosf(a), sinf(a));
+        }
+
+        // Same angles as PathArcTo() with the arc used by AddCircle()/AddCircleFilled(), so the points come out identical
+        int offset = 0;
+        for (int num_segments = 0; num_segments <= IM_DRAWLIST_CIRCLE_TABLE_MAX; num_segments++)
         {
-            const float a = ((float)i / (float)circle_vtx_count) * 2*IM_PI;
-            circle_vtx[i].x = cosf(a);
-            circle_vtx[i].y = sinf(a);
+            CirclesOffset[num_segments] = offset;
+            const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
+            for (int i = 0; num_segments > 0 && i <= num_segments; i++)
+            {
+                const float a = ((float)i / (float)num_segments) * a_max;
+                Circles[offset++] = ImVec2(cosf(a), sinf(a));
+            }
         }
-        circle_vtx_builds = true;
     }
+};
+static const ImDrawListCircleTables GCircleTables;
 
+// Equivalent to PathArcTo(centre, radius, 0.0f, IM_PI*2.0f*(num_segments-1)/num_segments, num_segments) for num_segments in [1, IM_DRAWLIST_CIRCLE_TABLE_MAX]
+static void PathCircleFromTable(ImVector<ImVec2>& path, const ImVec2& centre, float radius, int num_segments)
+{
+    if (radius == 0.0f)
+    {
+        path.push_back(centre);
+        return;
+    }
+    const ImVec2* circle_vtx = &GCircleTables.Circles[GCircleTables.CirclesOffset[num_segments]];
+    const int size = path.Size;
+    path.resize(size + num_segments + 1);
+    ImVec2* out = path.Data + size;
+    for (int i = 0; i <= num_segments; i++)
+        out[i] = ImVec2(centre.x + circle_vtx[i].x * radius, centre.y + circle_vtx[i].y * radius);
+}
+
+void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int a_min_of_12, int a_max_of_12)
+{
+    const ImVec2* circle_vtx = GCircleTables.Arc12;
+    const int circle_vtx_count = IM_ARRAYSIZE(GCircleTables.Arc12);
     if (radius == 0.0f || a_min_of_12 > a_max_of_12)
     {
         _Path.push_back(centre);
@@ -1054,8 +1235,15 @@ void ImDrawList::AddCircle(const ImVec2& centre, float radius, ImU32 col, int nu
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
-    const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
-    PathArcTo(centre, radius-0.5f, 0.0f, a_max, num_segments);
+    if (num_segments >= 1 && num_segments <= IM_DRAWLIST_CIRCLE_TABLE_MAX)
+    {
+        PathCircleFromTable(_Path, centre, radius-0.5f, num_segments);
+    }
+    else
+    {
+        const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(centre, radius-0.5f, 0.0f, a_max, num_segments);
+    }
     PathStroke(col, true, thickness);
 }
 
@@ -1064,8 +1252,15 @@ void ImDrawList::AddCircleFilled(const ImVec2& centre, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
-    const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
-    PathArcTo(centre, radius, 0.0f, a_max, num_segments);
+    if (num_segments >= 1 && num_segments <= IM_DRAWLIST_CIRCLE_TABLE_MAX)
+    {
+        PathCircleFromTable(_Path, centre, radius, num_segments);
+    }
+    else
+    {
+        const float a_max = IM_PI*2.0f * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(centre, radius, 0.0f, a_max, num_segments);
+    }
     PathFillConvex(col);
 }
 
@@ -1176,19 +1371,28 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& a, c
 //-----------------------------------------------------------------------------
 
 // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
+// The vertices are gathered in a scratch buffer of the context and copied back, so that neither buffer is allocated again from one frame to the next.
 void ImDrawData::DeIndexAllBuffers()
 {
-    ImVector<ImDrawVert> new_vtx_buffer;
+    ImVector<ImDrawVert>& scratch = GImGui->DeIndexVtxBuffer;
     TotalVtxCount = TotalIdxCount = 0;
     for (int i = 0; i < CmdListsCount; i++)
     {
         ImDrawList* cmd_list = CmdLists[i];
         if (cmd_list->IdxBuffer.empty())
             continue;
-        new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
-        for (int j = 0; j < cmd_list->IdxBuffer.Size; j++)
-            new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
-        cmd_list->VtxBuffer.swap(new_vtx_buffer);
+        scratch.resize(cmd_list->IdxBuffer.Size);
+        ImDrawVert* new_vtx_buffer = scratch.Data;
+        int j = 0;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            ImDrawCmd* cmd = &cmd_list->CmdBuffer[cmd_i];
+            for (unsigned int elem = 0; elem < cmd->ElemCount; elem++, j++)
+                new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd->VtxOffset + cmd_list->IdxBuffer[j]];
+            cmd->VtxOffset = 0;
+        }
+        cmd_list->VtxBuffer.resize(cmd_list->IdxBuffer.Size);
+        memcpy(cmd_list->VtxBuffer.Data, new_vtx_buffer, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawVert));
         cmd_list->IdxBuffer.resize(0);
         TotalVtxCount += cmd_list->VtxBuffer.Size;
     }
@@ -1286,6 +1490,7 @@ ImFontConfig::ImFontConfig()
     GlyphExtraSpacing = ImVec2(0.0f, 0.0f);
     GlyphOffset = ImVec2(0.0f, 0.0f);
     GlyphRanges = NULL;
+    GlyphRangesDynamic = NULL;
     MergeMode = false;
     RasterizerFlags = 0x00;
     RasterizerMultiply = 1.0f;
@@ -1351,12 +1556,18 @@ ImFontAtlas::ImFontAtlas()
     TexID = NULL;
     TexDesiredWidth = 0;
     TexGlyphPadding = 1;
+    CacheFilename = NULL;
+    DynamicTexHeight = 512;
+    BuildThreadsCount = 0;
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexWidth = TexHeight = 0;
     TexUvWhitePixel = ImVec2(0, 0);
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
         CustomRectIds[n] = -1;
+    TexDynamicY = 0;
+    DynamicGlyphs = NULL;
+    Generation = 0;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -1366,6 +1577,7 @@ ImFontAtlas::~ImFontAtlas()
 
 void    ImFontAtlas::ClearInputData()
 {
+    ImFontAtlasBuildClearDynamicGlyphs(this);
     for (int i = 0; i < ConfigData.Size; i++)
         if (ConfigData[i].FontData && ConfigData[i].FontDataOwnedByAtlas)
         {
@@ -1388,6 +1600,8 @@ void    ImFontAtlas::ClearInputData()
 
 void    ImFontAtlas::ClearTexData()
 {
+    ImFontAtlasBuildClearDynamicGlyphs(this);
+    TexDirtyRects.clear();
     if (TexPixelsAlpha8)
         ImGui::MemFree(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -1398,12 +1612,14 @@ void    ImFontAtlas::ClearTexData()
 
 void    ImFontAtlas::ClearFonts()
 {
+    ImFontAtlasBuildClearDynamicGlyphs(this);
     for (int i = 0; i < Fonts.Size; i++)
     {
         Fonts[i]->~ImFont();
         ImGui::MemFree(Fonts[i]);
     }
     Fonts.clear();
+    Generation++;
 }
 
 void    ImFontAtlas::Clear()
@@ -1431,6 +1647,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -1452,6 +1669,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
 
@@ -1518,6 +1736,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 
 ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     int data_size = 0;
     void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
     if (!data)
@@ -1551,6 +1770,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float si
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     const unsigned int buf_decompressed_size = stb_decompress_length((unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char *)ImGui::MemAlloc(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -1563,6 +1783,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_d
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg, const ImWchar* glyph_ranges)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     int compressed_ttf_size = (((int)strlen(compressed_ttf_data_base85) + 4) / 5) * 4;
     void* compressed_ttf = ImGui::MemAlloc((size_t)compressed_ttf_size);
     Decode85((const unsigned char*)compressed_ttf_data_base85, (unsigned char*)compressed_ttf);
@@ -1573,6 +1794,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
 
 int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     IM_ASSERT(id >= 0x10000);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
@@ -1586,6 +1808,7 @@ int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     IM_ASSERT(font != NULL);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
@@ -1610,7 +1833,17 @@ void ImFontAtlas::CalcCustomRectUV(const CustomRect* rect, ImVec2* out_uv_min, I
 
 bool    ImFontAtlas::Build()
 {
-    return ImFontAtlasBuildWithStbTruetype(this);
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
+    ImFontAtlasBuildClearDynamicGlyphs(this);
+    if (!CacheFilename || !ImFontAtlasBuildLoadCache(this, CacheFilename))
+    {
+        if (!ImFontAtlasBuildWithStbTruetype(this))
+            return false;
+        if (CacheFilename)
+            ImFontAtlasBuildSaveCache(this, CacheFilename);
+    }
+    ImFontAtlasBuildInitDynamicGlyphs(this);
+    return true;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -1630,6 +1863,48 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+// Glyphs rendered by one task of the second pass of ImFontAtlasBuildWithStbTruetype()
+#define IM_FONTATLAS_BUILD_TASK_GLYPHS 128
+struct ImFontAtlasBuildRenderTask
+{
+    const ImFontConfig*     Config;
+    const stbtt_fontinfo*   FontInfo;
+    stbtt_pack_range        Range;      // Slice of one of the ranges of the font, at most IM_FONTATLAS_BUILD_TASK_GLYPHS glyphs
+    stbrp_rect*             Rects;      // Packed rectangles for the glyphs in Range
+};
+
+struct ImFontAtlasBuildRenderContext
+{
+    const stbtt_pack_context*       PackContext;
+    ImFontAtlasBuildRenderTask*     Tasks;
+    int                             TasksCount;
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    std::atomic<int>                TasksNext;
+#else
+    int                             TasksNext;
+#endif
+};
+
+// Take tasks from the context until there are none left. Runs on the calling thread and on the font build threads.
+static void ImFontAtlasBuildRenderWorker(ImFontAtlasBuildRenderContext* ctx)
+{
+    // stbtt_PackFontRangesRenderIntoRects() changes the oversampling in the pack context, so every thread works on a copy
+    stbtt_pack_context spc = *ctx->PackContext;
+    for (int task_i = ctx->TasksNext++; task_i < ctx->TasksCount; task_i = ctx->TasksNext++)
+    {
+        ImFontAtlasBuildRenderTask& task = ctx->Tasks[task_i];
+        stbtt_PackFontRangesRenderIntoRects(&spc, task.FontInfo, &task.Range, 1, task.Rects);
+        if (task.Config->RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, task.Config->RasterizerMultiply);
+            for (const stbrp_rect* r = task.Rects; r != task.Rects + task.Range.num_chars; r++)
+                if (r->was_packed)
+                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc.pixels, r->x, r->y, r->w, r->h, spc.stride_in_bytes);
+        }
+    }
+}
+
 bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -1744,7 +2019,14 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     IM_ASSERT(buf_packedchars_n == total_glyphs_count);
     IM_ASSERT(buf_ranges_n == total_ranges_count);
 
-    // Create texture
+    // Create texture, with room below the baked glyphs for the glyphs loaded on demand
+    atlas->TexDynamicY = atlas->TexHeight;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        if (atlas->ConfigData[input_i].GlyphRangesDynamic && atlas->ConfigData[input_i].GlyphRangesDynamic[0])
+        {
+            atlas->TexHeight += ImMax(atlas->DynamicTexHeight, 0);
+            break;
+        }
     atlas->TexHeight = ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
@@ -1752,23 +2034,56 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // Second pass: render font characters
+    // The rectangles are packed already and do not overlap, so the glyphs are rendered in chunks on a pool of threads. Each
+    // chunk writes to its own rectangles only, and the atlas is identical to the one rendered on the calling thread.
+    ImFontAtlasBuildRenderTask* tasks = (ImFontAtlasBuildRenderTask*)ImGui::MemAlloc((size_t)total_glyphs_count * sizeof(ImFontAtlasBuildRenderTask));
+    int tasks_count = 0;
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
         ImFontConfig& cfg = atlas->ConfigData[input_i];
         ImFontTempBuildData& tmp = tmp_array[input_i];
-        stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        stbtt_PackFontRangesRenderIntoRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
-        if (cfg.RasterizerMultiply != 1.0f)
+        stbrp_rect* rects = tmp.Rects;
+        for (int i = 0; i < tmp.RangesCount; i++)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            for (const stbrp_rect* r = tmp.Rects; r != tmp.Rects + tmp.RectsCount; r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc.pixels, r->x, r->y, r->w, r->h, spc.stride_in_bytes);
+            const stbtt_pack_range& range = tmp.Ranges[i];
+            for (int j = 0; j < range.num_chars; j += IM_FONTATLAS_BUILD_TASK_GLYPHS)
+            {
+                ImFontAtlasBuildRenderTask& task = tasks[tasks_count++];
+                task.Config = &cfg;
+                task.FontInfo = &tmp.FontInfo;
+                task.Range = range;
+                task.Range.first_unicode_codepoint_in_range += j;
+                task.Range.num_chars = ImMin(range.num_chars - j, IM_FONTATLAS_BUILD_TASK_GLYPHS);
+                task.Range.chardata_for_range += j;
+                task.Rects = rects + j;
+            }
+            rects += range.num_chars;
         }
         tmp.Rects = NULL;
     }
 
+    ImFontAtlasBuildRenderContext render_ctx;
+    render_ctx.PackContext = &spc;
+    render_ctx.Tasks = tasks;
+    render_ctx.TasksCount = tasks_count;
+    render_ctx.TasksNext = 0;
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    int threads_count = atlas->BuildThreadsCount > 0 ? atlas->BuildThreadsCount : (int)std::thread::hardware_concurrency();
+    threads_count = ImMin(threads_count, tasks_count);
+    ImVector<std::thread*> threads;
+    for (int n = 1; n < threads_count; n++)
+        threads.push_back(new std::thread(ImFontAtlasBuildRenderWorker, &render_ctx));
+    ImFontAtlasBuildRenderWorker(&render_ctx);
+    for (int n = 0; n < threads.Size; n++)
+    {
+        threads[n]->join();
+        delete threads[n];
+    }
+#else
+    ImFontAtlasBuildRenderWorker(&render_ctx);
+#endif
+    ImGui::MemFree(tasks);
+
     // End packing
     stbtt_PackEnd(&spc);
     ImGui::MemFree(buf_rects);
@@ -1930,6 +2245,652 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
         atlas->Fonts[i]->BuildLookupTable();
 }
 
+//-----------------------------------------------------------------------------
+// ImFontAtlas cache file
+//-----------------------------------------------------------------------------
+// A cache file holds the baked atlas: alpha pixels, positions of the custom rectangles and the glyphs of every font.
+// It is only used when its header matches the version, the hash of the inputs to the build (font data and configuration, custom rectangles,
+// texture settings) and the hash of its own contents. Loading skips the stb_truetype rasterization and the packing altogether.
+// The file is read into memory with fread() rather than memory-mapped, which would need platform-specific code in this file.
+// Its content is in native byte order and layout, so a cache file is not portable across platforms.
+
+#define IM_FONT_ATLAS_CACHE_VERSION     2
+
+struct ImFontAtlasCacheHeader
+{
+    char        Magic[8];       // "ImFontAt"
+    ImU64       BuildHash;      // ImHash64() of the inputs to the build
+    ImU64       DataHash;       // ImHash64() of everything after the header
+    int         Version;        // IM_FONT_ATLAS_CACHE_VERSION
+    int         TexWidth, TexHeight;
+    int         TexDynamicY;
+    int         FontsCount;
+    int         CustomRectsCount;
+};
+
+// Followed by TexWidth*TexHeight alpha pixels, CustomRectsCount (X,Y) positions, then for each font:
+struct ImFontAtlasCacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    int         MetricsTotalSurface;
+    int         GlyphsCount;    // Followed by GlyphsCount ImFontGlyph
+};
+
+static ImU64 ImFontAtlasBuildCalcCacheHash(ImFontAtlas* atlas)
+{
+    const int layout[] = { IM_FONT_ATLAS_CACHE_VERSION, (int)sizeof(ImFontGlyph), (int)sizeof(ImWchar), (int)sizeof(ImFontAtlasCacheHeader), (int)sizeof(ImFontAtlasCacheFont) };
+    ImU64 h = ImHash64(layout, (int)sizeof(layout));
+    h = ImHash64(&atlas->TexDesiredWidth, (int)sizeof(int), h);
+    h = ImHash64(&atlas->TexGlyphPadding, (int)sizeof(int), h);
+    h = ImHash64(&atlas->DynamicTexHeight, (int)sizeof(int), h);
+    h = ImHash64(&atlas->Fonts.Size, (int)sizeof(int), h);
+
+    // Hash configurations field by field (no padding bytes)
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[input_i];
+        int font_index = 0;
+        while (font_index < atlas->Fonts.Size && atlas->Fonts[font_index] != cfg.DstFont)
+            font_index++;
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_size = 0;
+        while (ranges[ranges_size] && ranges[ranges_size + 1])
+            ranges_size += 2;
+        const int ints[] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, (int)cfg.PixelSnapH, (int)cfg.MergeMode, (int)cfg.RasterizerFlags, font_index };
+        const float floats[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.RasterizerMultiply };
+        h = ImHash64(ints, (int)sizeof(ints), h);
+        h = ImHash64(floats, (int)sizeof(floats), h);
+        h = ImHash64(ranges, (ranges_size + 1) * (int)sizeof(ImWchar), h);
+        const ImWchar* ranges_dynamic = cfg.GlyphRangesDynamic;
+        int ranges_dynamic_size = 0;
+        while (ranges_dynamic && ranges_dynamic[ranges_dynamic_size] && ranges_dynamic[ranges_dynamic_size + 1])
+            ranges_dynamic_size += 2;
+        h = ImHash64(&ranges_dynamic_size, (int)sizeof(int), h);
+        if (ranges_dynamic_size > 0)
+            h = ImHash64(ranges_dynamic, ranges_dynamic_size * (int)sizeof(ImWchar), h);
+        h = ImHash64(cfg.FontData, cfg.FontDataSize, h);
+    }
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
+        int font_index = -1;
+        for (int n = 0; n < atlas->Fonts.Size && r.Font; n++)
+            if (atlas->Fonts[n] == r.Font)
+                font_index = n;
+        const int ints[] = { (int)r.ID, (int)r.Width, (int)r.Height, font_index };
+        const float floats[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        h = ImHash64(ints, (int)sizeof(ints), h);
+        h = ImHash64(floats, (int)sizeof(floats), h);
+    }
+    return h;
+}
+
+bool    ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(atlas->ConfigData.Size > 0);
+    ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
+
+    int file_size = 0;
+    unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (!file_data)
+        return false;
+
+    // Validate header, sizes and hashes before touching the atlas
+    ImFontAtlasCacheHeader header;
+    bool valid = file_size > (int)sizeof(header);
+    if (valid)
+    {
+        memcpy(&header, file_data, sizeof(header));
+        valid = memcmp(header.Magic, "ImFontAt", 8) == 0 && header.Version == IM_FONT_ATLAS_CACHE_VERSION && header.BuildHash == ImFontAtlasBuildCalcCacheHash(atlas) &&
+            header.FontsCount == atlas->Fonts.Size && header.CustomRectsCount == atlas->CustomRects.Size &&
+            header.TexWidth > 0 && header.TexHeight > 0 && header.TexHeight <= file_size / header.TexWidth && header.TexDynamicY >= 0 && header.TexDynamicY <= header.TexHeight &&
+            ImHash64(file_data + sizeof(header), file_size - (int)sizeof(header)) == header.DataHash;
+    }
+    int fonts_offset = 0;
+    if (valid)
+    {
+        fonts_offset = (int)sizeof(header) + header.TexWidth * header.TexHeight + header.CustomRectsCount * 2 * (int)sizeof(unsigned short);
+        int offset = fonts_offset;
+        for (int font_i = 0; font_i < header.FontsCount && valid; font_i++)
+        {
+            ImFontAtlasCacheFont font_header;
+            valid = file_size - offset >= (int)sizeof(font_header);
+            if (!valid)
+                break;
+            memcpy(&font_header, file_data + offset, sizeof(font_header));
+            offset += (int)sizeof(font_header);
+            valid = font_header.GlyphsCount >= 0 && font_header.GlyphsCount <= (file_size - offset) / (int)sizeof(ImFontGlyph);
+            offset += valid ? font_header.GlyphsCount * (int)sizeof(ImFontGlyph) : 0;
+        }
+        valid = valid && offset == file_size;
+    }
+    if (!valid)
+    {
+        ImGui::MemFree(file_data);
+        return false;
+    }
+    const unsigned char* pixels = file_data + sizeof(header);
+    const unsigned char* rects = pixels + header.TexWidth * header.TexHeight;
+    const unsigned char* fonts = file_data + fonts_offset;
+
+    // Texture
+    atlas->TexID = NULL;
+    atlas->ClearTexData();
+    atlas->TexWidth = header.TexWidth;
+    atlas->TexHeight = header.TexHeight;
+    atlas->TexDynamicY = header.TexDynamicY;
+    atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc(atlas->TexWidth * atlas->TexHeight);
+    memcpy(atlas->TexPixelsAlpha8, pixels, (size_t)(atlas->TexWidth * atlas->TexHeight));
+
+    // Custom rectangles
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        unsigned short xy[2];
+        memcpy(xy, rects + i * sizeof(xy), sizeof(xy));
+        atlas->CustomRects[i].X = xy[0];
+        atlas->CustomRects[i].Y = xy[1];
+    }
+
+    // Fonts: the glyphs are stored as they were at the end of the build, including custom rectangle glyphs
+    const unsigned char* p = fonts;
+    ImVector<ImFontAtlasCacheFont> font_headers;
+    font_headers.resize(atlas->Fonts.Size);
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        memcpy(&font_headers[font_i], p, sizeof(ImFontAtlasCacheFont));
+        p += sizeof(ImFontAtlasCacheFont) + font_headers[font_i].GlyphsCount * sizeof(ImFontGlyph);
+    }
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[input_i];
+        if (!cfg.GlyphRanges)
+            cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
+        int font_i = 0;
+        while (atlas->Fonts[font_i] != cfg.DstFont)
+            font_i++;
+        ImFontAtlasBuildSetupFont(atlas, cfg.DstFont, &cfg, font_headers[font_i].Ascent, font_headers[font_i].Descent);
+    }
+    p = fonts;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        const ImFontAtlasCacheFont& font_header = font_headers[font_i];
+        p += sizeof(ImFontAtlasCacheFont);
+        font->FontSize = font_header.FontSize;
+        font->MetricsTotalSurface = font_header.MetricsTotalSurface;
+        font->Glyphs.resize(font_header.GlyphsCount);
+        if (font_header.GlyphsCount > 0)
+            memcpy(font->Glyphs.Data, p, font_header.GlyphsCount * sizeof(ImFontGlyph));
+        p += font_header.GlyphsCount * sizeof(ImFontGlyph);
+    }
+    ImGui::MemFree(file_data);
+
+    // What ImFontAtlasBuildFinish() does, minus adding the custom rectangle glyphs (already in the cache)
+    ImFontAtlasBuildRenderDefaultTexData(atlas);
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+        atlas->Fonts[i]->BuildLookupTable();
+    return true;
+}
+
+bool    ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL);
+
+    ImVector<unsigned char> buf;
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "ImFontAt", 8);
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    header.BuildHash = ImFontAtlasBuildCalcCacheHash(atlas);
+    header.TexWidth = atlas->TexWidth;
+    header.TexHeight = atlas->TexHeight;
+    header.TexDynamicY = atlas->TexDynamicY;
+    header.FontsCount = atlas->Fonts.Size;
+    header.CustomRectsCount = atlas->CustomRects.Size;
+
+    int data_size = atlas->TexWidth * atlas->TexHeight + atlas->CustomRects.Size * 2 * (int)sizeof(unsigned short);
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+        data_size += (int)sizeof(ImFontAtlasCacheFont) + atlas->Fonts[font_i]->Glyphs.Size * (int)sizeof(ImFontGlyph);
+    buf.resize((int)sizeof(header) + data_size);
+    unsigned char* p = buf.Data + sizeof(header);
+    memcpy(p, atlas->TexPixelsAlpha8, (size_t)(atlas->TexWidth * atlas->TexHeight));
+    p += atlas->TexWidth * atlas->TexHeight;
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const unsigned short xy[2] = { atlas->CustomRects[i].X, atlas->CustomRects[i].Y };
+        memcpy(p, xy, sizeof(xy));
+        p += sizeof(xy);
+    }
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        const ImFont* font = atlas->Fonts[font_i];
+        ImFontAtlasCacheFont font_header;
+        memset(&font_header, 0, sizeof(font_header));
+        font_header.FontSize = font->FontSize;
+        font_header.Ascent = font->Ascent;
+        font_header.Descent = font->Descent;
+        font_header.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_header.GlyphsCount = font->Glyphs.Size;
+        memcpy(p, &font_header, sizeof(font_header));
+        p += sizeof(font_header);
+        if (font->Glyphs.Size > 0)
+            memcpy(p, font->Glyphs.Data, font->Glyphs.Size * sizeof(ImFontGlyph));
+        p += font->Glyphs.Size * sizeof(ImFontGlyph);
+    }
+    IM_ASSERT(p == buf.Data + buf.Size);
+    header.DataHash = ImHash64(buf.Data + sizeof(header), data_size);
+    memcpy(buf.Data, &header, sizeof(header));
+
+    FILE* f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool ok = fwrite(buf.Data, 1, (size_t)buf.Size, f) == (size_t)buf.Size;
+    return (fclose(f) == 0) && ok;
+}
+
+//-----------------------------------------------------------------------------
+// ImFontAtlas glyphs loaded on demand
+//-----------------------------------------------------------------------------
+// The lookup table of a font marks the codepoints of its GlyphRangesDynamic that have no glyph yet with IM_FONTGLYPH_INDEX_DYNAMIC.
+// FindGlyph() queues those codepoints and returns the fallback glyph. At the start of the next frame, UpdateDynamicGlyphs() rasterizes them
+// with the same settings as Build() and packs them with a stb_rect_pack context of their own, in the texture area below TexDynamicY.
+// stb_rect_pack cannot free single rectangles: when the area is full, the glyphs used in the previous frame are packed again from scratch
+// and moved, and the others are evicted. A codepoint that does not fit even then is not requested again until something else is evicted.
+
+#define IM_FONTGLYPH_INDEX_DYNAMIC      ((unsigned short)0xFFFE)    // In ImFont::IndexLookup: no glyph yet, but it can be loaded. 0xFFFF: no glyph.
+
+struct ImFontAtlasDynamicGlyphs
+{
+    stbrp_context               PackContext;    // Packs the texture area below TexDynamicY
+    ImVector<stbrp_node>        PackNodes;
+    ImVector<stbtt_fontinfo>    FontInfos;      // For each entry of ConfigData using GlyphRangesDynamic (data == NULL for the others)
+    ImVector<ImU32>             Requests;       // Keys of the codepoints queued by FindGlyph(): (font index << 16) | codepoint
+    ImGuiStorage                RequestsSet;    // Keys in Requests, to queue a codepoint only once
+    ImGuiStorage                Failed;         // Keys of the codepoints that did not fit in the texture
+    int                         Frame;          // Incremented by UpdateDynamicGlyphs(), stored in ImFont::DynamicGlyphsLastUsed
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    std::mutex                  RequestsMutex;  // FindGlyph() may be called by threads recording draw lists in parallel
+#endif
+};
+
+static ImU32 ImFontAtlasBuildDynamicGlyphKey(const ImFontAtlas* atlas, const ImFont* font, ImWchar c)
+{
+    int font_index = 0;
+    while (font_index < atlas->Fonts.Size && atlas->Fonts[font_index] != font)
+        font_index++;
+    return ((ImU32)font_index << 16) | (ImU32)c;
+}
+
+static bool ImFontAtlasBuildRangesContain(const ImWchar* ranges, ImWchar c)
+{
+    for (; ranges && ranges[0] && ranges[1]; ranges += 2)
+        if (c >= ranges[0] && c <= ranges[1])
+            return true;
+    return false;
+}
+
+static void ImFontAtlasBuildResetDynamicPacker(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    const int pad = atlas->TexGlyphPadding;
+    dyn->PackNodes.resize(atlas->TexWidth - pad);
+    stbrp_init_target(&dyn->PackContext, atlas->TexWidth - pad, atlas->TexHeight - atlas->TexDynamicY - pad, dyn->PackNodes.Data, dyn->PackNodes.Size);
+}
+
+static void ImFontAtlasBuildAddDirtyRect(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexPixelsRGBA32)
+        for (int j = y; j < y + h; j++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + j * atlas->TexWidth + x;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + j * atlas->TexWidth + x;
+            for (int i = 0; i < w; i++)
+                dst[i] = IM_COL32(255, 255, 255, (unsigned int)src[i]);
+        }
+
+    // Keep the list short if the renderer does not consume it every frame
+    ImVector<ImFontAtlas::DirtyRect>& rects = atlas->TexDirtyRects;
+    ImFontAtlas::DirtyRect r = { x, y, w, h };
+    rects.push_back(r);
+    if (rects.Size > 8)
+    {
+        int x0 = rects[0].X, y0 = rects[0].Y, x1 = rects[0].X + rects[0].Width, y1 = rects[0].Y + rects[0].Height;
+        for (int n = 1; n < rects.Size; n++)
+        {
+            x0 = ImMin(x0, rects[n].X);
+            y0 = ImMin(y0, rects[n].Y);
+            x1 = ImMax(x1, rects[n].X + rects[n].Width);
+            y1 = ImMax(y1, rects[n].Y + rects[n].Height);
+        }
+        ImFontAtlas::DirtyRect bounds = { x0, y0, x1 - x0, y1 - y0 };
+        rects.resize(1);
+        rects[0] = bounds;
+    }
+}
+
+void ImFontAtlasBuildInitDynamicGlyphs(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuildClearDynamicGlyphs(atlas);
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+        atlas->Fonts[i]->DynamicGlyphsStart = atlas->Fonts[i]->Glyphs.Size;
+
+    bool has_dynamic_ranges = false;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        if (atlas->ConfigData[input_i].GlyphRangesDynamic && atlas->ConfigData[input_i].GlyphRangesDynamic[0])
+            has_dynamic_ranges = true;
+    if (!has_dynamic_ranges || atlas->TexHeight - atlas->TexDynamicY <= atlas->TexGlyphPadding || !atlas->TexPixelsAlpha8)
+        return;
+
+    ImFontAtlasDynamicGlyphs* dyn = (ImFontAtlasDynamicGlyphs*)ImGui::MemAlloc(sizeof(ImFontAtlasDynamicGlyphs));
+    IM_PLACEMENT_NEW(dyn) ImFontAtlasDynamicGlyphs();
+    dyn->Frame = 0;
+    dyn->FontInfos.resize(atlas->ConfigData.Size);
+    memset(dyn->FontInfos.Data, 0, (size_t)dyn->FontInfos.Size * sizeof(stbtt_fontinfo));
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[input_i];
+        if (!cfg.GlyphRangesDynamic || !cfg.FontData)
+            continue;
+        const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+        if (font_offset < 0 || !stbtt_InitFont(&dyn->FontInfos[input_i], (unsigned char*)cfg.FontData, font_offset))
+            dyn->FontInfos[input_i].data = NULL;
+    }
+    atlas->DynamicGlyphs = dyn;
+    ImFontAtlasBuildResetDynamicPacker(atlas);
+}
+
+void ImFontAtlasBuildClearDynamicGlyphs(ImFontAtlas* atlas)
+{
+    for (int i = 0; i < atlas->Fonts.Size; i++)
+        atlas->Fonts[i]->DynamicGlyphsLastUsed.clear();
+    if (atlas->DynamicGlyphs)
+    {
+        atlas->DynamicGlyphs->~ImFontAtlasDynamicGlyphs();
+        ImGui::MemFree(atlas->DynamicGlyphs);
+        atlas->DynamicGlyphs = NULL;
+    }
+}
+
+// Called by FindGlyph() for a codepoint marked IM_FONTGLYPH_INDEX_DYNAMIC
+static void ImFontAtlasBuildQueueDynamicGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c)
+{
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    const ImU32 key = ImFontAtlasBuildDynamicGlyphKey(atlas, font, c);
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    std::lock_guard<std::mutex> lock(dyn->RequestsMutex);
+#endif
+    int* queued = dyn->RequestsSet.GetIntRef(key, 0);
+    if (*queued)
+        return;
+    *queued = 1;
+    dyn->Requests.push_back(key);
+}
+
+// Called by FindGlyph() for a glyph loaded on demand, to keep it from being evicted
+static void ImFontAtlasBuildTouchDynamicGlyph(ImFontAtlas* atlas, const ImFont* font, int last_used_i)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    if (GImGui->DrawingInParallel)
+    {
+        std::lock_guard<std::mutex> lock(dyn->RequestsMutex);
+        font->DynamicGlyphsLastUsed.Data[last_used_i] = dyn->Frame;
+        return;
+    }
+#endif
+    font->DynamicGlyphsLastUsed.Data[last_used_i] = dyn->Frame;
+}
+
+// Called by ImFont::BuildLookupTable()
+static void ImFontAtlasBuildMarkDynamicGlyphs(ImFontAtlas* atlas, ImFont* font)
+{
+    const ImGuiStorage* failed = (atlas->DynamicGlyphs && !atlas->DynamicGlyphs->Failed.Data.empty()) ? &atlas->DynamicGlyphs->Failed : NULL;
+    const ImU32 font_key = failed ? ImFontAtlasBuildDynamicGlyphKey(atlas, font, 0) : 0;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[input_i];
+        if (cfg.DstFont != font || !cfg.GlyphRangesDynamic)
+            continue;
+        for (const ImWchar* range = cfg.GlyphRangesDynamic; range[0] && range[1]; range += 2)
+        {
+            font->GrowIndex((int)range[1] + 1);
+            for (int c = range[0]; c <= range[1]; c++)
+                if (font->IndexLookup.Data[c] == (unsigned short)-1 && (!failed || !failed->GetInt(font_key | (ImU32)c)))
+                    font->IndexLookup.Data[c] = IM_FONTGLYPH_INDEX_DYNAMIC;
+        }
+    }
+}
+
+// Drop the glyphs loaded on demand that were not used in the previous frame, and pack the others again. Returns the number of glyphs dropped.
+static int ImFontAtlasBuildEvictDynamicGlyphs(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    struct KeptGlyph
+    {
+        ImFont*     Font;
+        int         GlyphIndex;
+        int         X, Y, Width, Height;    // Pixels of the glyph in the texture
+        int         PixelsOffset;           // In pixels
+    };
+    ImVector<KeptGlyph> kept;
+    ImVector<stbrp_rect> rects;
+    ImVector<unsigned char> pixels;
+    int evicted_count = 0;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        for (int glyph_i = font->DynamicGlyphsStart; glyph_i < font->Glyphs.Size; glyph_i++)
+        {
+            const ImFontGlyph& glyph = font->Glyphs[glyph_i];
+            const int last_used_i = glyph_i - font->DynamicGlyphsStart;
+            if (glyph.Codepoint == '\t')        // Copy of the space glyph, made again by BuildLookupTable()
+                continue;
+            if (last_used_i >= font->DynamicGlyphsLastUsed.Size || font->DynamicGlyphsLastUsed[last_used_i] < dyn->Frame - 1)
+            {
+                font->MetricsTotalSurface -= (int)((glyph.U1 - glyph.U0) * atlas->TexWidth + 1.99f) * (int)((glyph.V1 - glyph.V0) * atlas->TexHeight + 1.99f);
+                evicted_count++;
+                continue;
+            }
+            KeptGlyph k;
+            k.Font = font;
+            k.GlyphIndex = glyph_i;
+            k.X = (int)(glyph.U0 * atlas->TexWidth + 0.5f);
+            k.Y = (int)(glyph.V0 * atlas->TexHeight + 0.5f);
+            k.Width = (int)(glyph.U1 * atlas->TexWidth + 0.5f) - k.X;
+            k.Height = (int)(glyph.V1 * atlas->TexHeight + 0.5f) - k.Y;
+            k.PixelsOffset = pixels.Size;
+            kept.push_back(k);
+            stbrp_rect r;
+            memset(&r, 0, sizeof(r));
+            r.w = (stbrp_coord)(k.Width + atlas->TexGlyphPadding);
+            r.h = (stbrp_coord)(k.Height + atlas->TexGlyphPadding);
+            rects.push_back(r);
+            pixels.resize(pixels.Size + k.Width * k.Height);
+            for (int y = 0; y < k.Height; y++)
+                memcpy(pixels.Data + k.PixelsOffset + y * k.Width, atlas->TexPixelsAlpha8 + (k.Y + y) * atlas->TexWidth + k.X, (size_t)k.Width);
+        }
+    }
+    if (evicted_count == 0)
+        return 0;
+
+    // Pack and copy back the glyphs we keep
+    ImFontAtlasBuildResetDynamicPacker(atlas);
+    if (rects.Size > 0)
+        stbrp_pack_rects(&dyn->PackContext, rects.Data, rects.Size);
+    memset(atlas->TexPixelsAlpha8 + atlas->TexDynamicY * atlas->TexWidth, 0, (size_t)((atlas->TexHeight - atlas->TexDynamicY) * atlas->TexWidth));
+    const float ipw = 1.0f / atlas->TexWidth, iph = 1.0f / atlas->TexHeight;
+    for (int i = 0; i < kept.Size; i++)
+    {
+        KeptGlyph& k = kept[i];
+        ImFontGlyph& glyph = k.Font->Glyphs[k.GlyphIndex];
+        if (!rects[i].was_packed)
+        {
+            k.Font->MetricsTotalSurface -= (int)((glyph.U1 - glyph.U0) * atlas->TexWidth + 1.99f) * (int)((glyph.V1 - glyph.V0) * atlas->TexHeight + 1.99f);
+            k.Font = NULL;
+            continue;
+        }
+        const int x = rects[i].x + atlas->TexGlyphPadding;
+        const int y = rects[i].y + atlas->TexGlyphPadding + atlas->TexDynamicY;
+        for (int row = 0; row < k.Height; row++)
+            memcpy(atlas->TexPixelsAlpha8 + (y + row) * atlas->TexWidth + x, pixels.Data + k.PixelsOffset + row * k.Width, (size_t)k.Width);
+        glyph.U0 = x * ipw;
+        glyph.V0 = y * iph;
+        glyph.U1 = (x + k.Width) * ipw;
+        glyph.V1 = (y + k.Height) * iph;
+    }
+
+    // Compact the glyphs of every font
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        int dst_i = font->DynamicGlyphsStart;
+        for (int i = 0; i < kept.Size; i++)
+            if (kept[i].Font == font)
+            {
+                font->DynamicGlyphsLastUsed[dst_i - font->DynamicGlyphsStart] = font->DynamicGlyphsLastUsed[kept[i].GlyphIndex - font->DynamicGlyphsStart];
+                font->Glyphs[dst_i++] = font->Glyphs[kept[i].GlyphIndex];
+            }
+        font->Glyphs.resize(dst_i);
+        font->DynamicGlyphsLastUsed.resize(dst_i - font->DynamicGlyphsStart);
+    }
+
+    dyn->Failed.Clear();
+    ImFontAtlasBuildAddDirtyRect(atlas, 0, atlas->TexDynamicY, atlas->TexWidth, atlas->TexHeight - atlas->TexDynamicY);
+    return evicted_count;
+}
+
+bool    ImFontAtlas::UpdateDynamicGlyphs()
+{
+    ImFontAtlasDynamicGlyphs* dyn = DynamicGlyphs;
+    if (!dyn)
+        return false;
+    dyn->Frame++;
+    if (dyn->Requests.empty())
+        return false;
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
+
+    // Gather the rectangles of the requested glyphs
+    struct GlyphLoad
+    {
+        ImU32               Key;
+        ImFont*             Font;
+        int                 ConfigIndex;
+        stbtt_pack_range    Range;
+        stbtt_packedchar    PackedChar;
+    };
+    ImVector<GlyphLoad> loads;
+    ImVector<stbrp_rect> rects;
+    stbtt_pack_context spc;
+    stbtt_PackBegin(&spc, NULL, TexWidth, TexHeight, 0, TexGlyphPadding, NULL);
+    spc.pixels = TexPixelsAlpha8;
+    for (int request_i = 0; request_i < dyn->Requests.Size; request_i++)
+    {
+        const ImU32 key = dyn->Requests[request_i];
+        const int font_i = (int)(key >> 16);
+        const ImWchar c = (ImWchar)(key & 0xFFFF);
+        if (font_i >= Fonts.Size)
+            continue;
+        ImFont* font = Fonts[font_i];
+        if ((int)c >= font->IndexLookup.Size || font->IndexLookup[(int)c] != IM_FONTGLYPH_INDEX_DYNAMIC)
+            continue;
+
+        // The first input of the font that can load this codepoint
+        int input_i = 0;
+        while (input_i < ConfigData.Size && (ConfigData[input_i].DstFont != font || !dyn->FontInfos[input_i].data || !ImFontAtlasBuildRangesContain(ConfigData[input_i].GlyphRangesDynamic, c)))
+            input_i++;
+        if (input_i == ConfigData.Size)
+        {
+            font->IndexLookup[(int)c] = (unsigned short)-1;
+            continue;
+        }
+
+        const ImFontConfig& cfg = ConfigData[input_i];
+        GlyphLoad load;
+        memset(&load, 0, sizeof(load));
+        load.Key = key;
+        load.Font = font;
+        load.ConfigIndex = input_i;
+        load.Range.font_size = cfg.SizePixels;
+        load.Range.first_unicode_codepoint_in_range = (int)c;
+        load.Range.num_chars = 1;
+        stbrp_rect r;
+        memset(&r, 0, sizeof(r));
+        stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
+        stbtt_PackFontRangesGatherRects(&spc, &dyn->FontInfos[input_i], &load.Range, 1, &r);
+        r.id = loads.Size;
+        loads.push_back(load);
+        rects.push_back(r);
+    }
+    dyn->Requests.clear();
+    dyn->RequestsSet.Clear();
+
+    // Pack them, making room if needed
+    bool all_packed = true, evicted = false;
+    if (rects.Size > 0)
+        stbrp_pack_rects(&dyn->PackContext, rects.Data, rects.Size);
+    for (int i = 0; i < rects.Size; i++)
+        all_packed &= rects[i].was_packed != 0;
+    if (!all_packed && ImFontAtlasBuildEvictDynamicGlyphs(this) > 0)
+    {
+        evicted = true;
+        for (int i = 0; i < rects.Size; i++)
+            rects[i].x = rects[i].y = rects[i].was_packed = 0;
+        stbrp_pack_rects(&dyn->PackContext, rects.Data, rects.Size);
+    }
+
+    // Render them and add them to their fonts
+    int dirty_x0 = TexWidth, dirty_y0 = TexHeight, dirty_x1 = 0, dirty_y1 = 0;
+    for (int i = 0; i < rects.Size; i++)
+    {
+        stbrp_rect& r = rects[i];
+        GlyphLoad& load = loads[r.id];
+        if (!r.was_packed)
+        {
+            dyn->Failed.SetInt(load.Key, 1);
+            continue;
+        }
+        r.y += (stbrp_coord)TexDynamicY;
+        dirty_x0 = ImMin(dirty_x0, (int)r.x);
+        dirty_y0 = ImMin(dirty_y0, (int)r.y);
+        dirty_x1 = ImMax(dirty_x1, (int)(r.x + r.w));
+        dirty_y1 = ImMax(dirty_y1, (int)(r.y + r.h));
+
+        const ImFontConfig& cfg = ConfigData[load.ConfigIndex];
+        load.Range.chardata_for_range = &load.PackedChar;
+        stbtt_PackFontRangesRenderIntoRects(&spc, &dyn->FontInfos[load.ConfigIndex], &load.Range, 1, &r);
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc.pixels, r.x, r.y, r.w, r.h, spc.stride_in_bytes);
+        }
+
+        // Same as the third pass of ImFontAtlasBuildWithStbTruetype()
+        ImFont* dst_font = load.Font;
+        const float off_x = cfg.GlyphOffset.x;
+        const float off_y = cfg.GlyphOffset.y + (float)(int)(dst_font->Ascent + 0.5f);
+        stbtt_aligned_quad q;
+        float dummy_x = 0.0f, dummy_y = 0.0f;
+        stbtt_GetPackedQuad(&load.PackedChar, TexWidth, TexHeight, 0, &dummy_x, &dummy_y, &q, 0);
+        dst_font->AddGlyph((ImWchar)load.Range.first_unicode_codepoint_in_range, q.x0 + off_x, q.y0 + off_y, q.x1 + off_x, q.y1 + off_y, q.s0, q.t0, q.s1, q.t1, load.PackedChar.xadvance);
+        dst_font->DynamicGlyphsLastUsed.push_back(dyn->Frame);
+    }
+    stbtt_PackEnd(&spc);
+
+    if (dirty_x1 > dirty_x0)
+        ImFontAtlasBuildAddDirtyRect(this, dirty_x0, dirty_y0, dirty_x1 - dirty_x0, dirty_y1 - dirty_y0);
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        for (int input_i = 0; input_i < ConfigData.Size; input_i++)
+            if (ConfigData[input_i].DstFont == Fonts[font_i] && dyn->FontInfos[input_i].data)
+            {
+                Fonts[font_i]->BuildLookupTable();
+                break;
+            }
+    return evicted || dirty_x1 > dirty_x0;
+}
+
 // Retrieve list of range (2 int per range, values are inclusive)
 const ImWchar*   ImFontAtlas::GetGlyphRangesDefault()
 {
@@ -2133,17 +3094,21 @@ void    ImFont::ClearOutputData()
     ContainerAtlas = NULL;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    DynamicGlyphsStart = 0;
+    DynamicGlyphsLastUsed.clear();
 }
 
 void ImFont::BuildLookupTable()
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     int max_codepoint = 0;
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
 
-    IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    IM_ASSERT(Glyphs.Size < IM_FONTGLYPH_INDEX_DYNAMIC); // -1 and -2 are reserved
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    FallbackGlyph = NULL;   // May point to the previous storage of Glyphs
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
@@ -2151,27 +3116,34 @@ void ImFont::BuildLookupTable()
         IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
         IndexLookup[codepoint] = (unsigned short)i;
     }
+    if (ContainerAtlas)
+        ImFontAtlasBuildMarkDynamicGlyphs(ContainerAtlas, this);
 
     // Create a glyph to handle TAB
     // FIXME: Needs proper TAB handling but it needs to be contextualized (or we could arbitrary say that each string starts at "column 0" ?)
     if (FindGlyph((unsigned short)' '))
     {
-        if (Glyphs.back().Codepoint != '\t')   // So we can call this function multiple times
+        int tab_index = (int)IndexLookup[(int)'\t'];
+        if (tab_index >= Glyphs.Size)   // So we can call this function multiple times
+        {
             Glyphs.resize(Glyphs.Size + 1);
-        ImFontGlyph& tab_glyph = Glyphs.back();
+            tab_index = Glyphs.Size - 1;
+        }
+        ImFontGlyph& tab_glyph = Glyphs[tab_index];
         tab_glyph = *FindGlyph((unsigned short)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= 4;
         IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (unsigned short)(Glyphs.Size-1);
+        IndexLookup[(int)tab_glyph.Codepoint] = (unsigned short)tab_index;
     }
 
-    FallbackGlyph = NULL;
     FallbackGlyph = FindGlyph(FallbackChar);
     FallbackAdvanceX = FallbackGlyph ? FallbackGlyph->AdvanceX : 0.0f;
-    for (int i = 0; i < max_codepoint + 1; i++)
+    for (int i = 0; i < IndexAdvanceX.Size; i++)
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
+    if (ContainerAtlas)
+        ContainerAtlas->Generation++;
 }
 
 void ImFont::SetFallbackChar(ImWchar c)
@@ -2191,6 +3163,7 @@ void ImFont::GrowIndex(int new_size)
 
 void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     Glyphs.resize(Glyphs.Size + 1);
     ImFontGlyph& glyph = Glyphs.back();
     glyph.Codepoint = (ImWchar)codepoint;
@@ -2213,6 +3186,7 @@ void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1,
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_FontAtlas);
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
     int index_size = IndexLookup.Size;
 
@@ -2224,6 +3198,7 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (unsigned short)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    ContainerAtlas->Generation++;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -2231,12 +3206,44 @@ const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
     if (c < IndexLookup.Size)
     {
         const unsigned short i = IndexLookup[c];
-        if (i != (unsigned short)-1)
+        if (i < IM_FONTGLYPH_INDEX_DYNAMIC)
+        {
+            if ((unsigned int)(i - DynamicGlyphsStart) < (unsigned int)DynamicGlyphsLastUsed.Size)
+                ImFontAtlasBuildTouchDynamicGlyph(ContainerAtlas, this, i - DynamicGlyphsStart);
             return &Glyphs.Data[i];
+        }
+        if (i == IM_FONTGLYPH_INDEX_DYNAMIC && ContainerAtlas->DynamicGlyphs)
+            ImFontAtlasBuildQueueDynamicGlyph(ContainerAtlas, this, c);
     }
     return FallbackGlyph;
 }
 
+// Length of the run of printable ASCII characters (32..127) at the start of [s, s_end). Those characters are one byte each and
+// none of them needs special handling, so the text functions below measure and render such runs without decoding or testing them.
+static inline int CountPrintableAscii(const char* s, const char* s_end)
+{
+    const char* p = s;
+    if (p == s_end || (signed char)*p < ' ')
+        return 0;
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128i space = _mm_set1_epi8(' ');
+    for (; s_end - p >= 16; p += 16)
+    {
+        // As signed bytes, control characters and UTF-8 lead/continuation bytes (0x80..0xFF) both compare lower than ' '
+        int mask = _mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)p), space));
+        if (mask != 0)
+        {
+            for (; !(mask & 1); mask >>= 1)
+                p++;
+            return (int)(p - s);
+        }
+    }
+#endif
+    while (p < s_end && (signed char)*p >= ' ')
+        p++;
+    return (int)(p - s);
+}
+
 const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
@@ -2263,36 +3270,48 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* prev_word_end = NULL;
     bool inside_word = true;
 
+    // Runs of printable ASCII characters are scanned in windows of at most 64 bytes, as we usually stop after one line
     const char* s = text;
+    const char* ascii_run_end = text;
     while (s < text_end)
     {
         unsigned int c = (unsigned int)*s;
-        const char* next_s;
-        if (c < 0x80)
-            next_s = s + 1;
+        const char* next_s = s + 1;
+        float char_width;
+        bool is_space;
+        if (s < ascii_run_end || (ascii_run_end = s + CountPrintableAscii(s, (text_end - s > 64) ? s + 64 : text_end)) > s)
+        {
+            // Printable ASCII: no decoding, no control characters and the only blank is ' '
+            char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
+            is_space = (c == ' ');
+        }
         else
-            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
-        if (c == 0)
-            break;
-
-        if (c < 32)
         {
-            if (c == '\n')
-            {
-                line_width = word_width = blank_width = 0.0f;
-                inside_word = true;
-                s = next_s;
-                continue;
-            }
-            if (c == '\r')
+            if (c >= 0x80)
+                next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0)
+                break;
+
+            if (c < 32)
             {
-                s = next_s;
-                continue;
+                if (c == '\n')
+                {
+                    line_width = word_width = blank_width = 0.0f;
+                    inside_word = true;
+                    s = next_s;
+                    continue;
+                }
+                if (c == '\r')
+                {
+                    s = next_s;
+                    continue;
+                }
             }
+            char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX[(int)c] : FallbackAdvanceX);
+            is_space = ImCharIsSpace(c);
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX[(int)c] : FallbackAdvanceX);
-        if (ImCharIsSpace(c))
+        if (is_space)
         {
             if (inside_word)
             {
@@ -2336,7 +3355,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     return s;
 }
 
-ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVector<int>* out_wrap_eols) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
@@ -2361,6 +3380,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
+                if (out_wrap_eols)
+                    out_wrap_eols->push_back((int)(word_wrap_eol - text_begin));
             }
 
             if (s >= word_wrap_eol)
@@ -2381,6 +3402,25 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path: add up the advances of a run of printable ASCII characters
+        const char* run_end = s + CountPrintableAscii(s, (word_wrap_enabled && word_wrap_eol < text_end) ? word_wrap_eol : text_end);
+        if (s < run_end)
+        {
+            const float* index_advance_x = IndexAdvanceX.Data;
+            const int index_advance_x_size = IndexAdvanceX.Size;
+            for (; s < run_end; s++)
+            {
+                const int c = (unsigned char)*s;
+                const float char_width = (c < index_advance_x_size ? index_advance_x[c] : FallbackAdvanceX) * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end) // Reached max_width
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -2444,7 +3484,7 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     }
 }
 
-void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
+void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip, const int* wrap_eols) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui functions generally already provides a valid text_end, so this is merely to handle direct calls.
@@ -2474,16 +3514,23 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
     draw_list->PrimReserve(idx_count_max, vtx_count_max);
 
+    // Only the vertices are written while walking the text. The indices of all the quads follow the same pattern and are written at the end.
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
-    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
-    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    const ImDrawVert* vtx_begin = vtx_write;
+    const unsigned short* index_lookup = IndexLookup.Data;
+    const int index_lookup_size = IndexLookup.Size;
+    const int dynamic_glyphs_start = DynamicGlyphsStart;
 
     while (s < text_end)
     {
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
-            if (!word_wrap_eol)
+            if (!word_wrap_eol && wrap_eols)
+            {
+                word_wrap_eol = text_begin + *wrap_eols++;
+            }
+            else if (!word_wrap_eol)
             {
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
@@ -2506,6 +3553,39 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+        // Fast path: render a run of printable ASCII characters, looking up their glyphs directly
+        const char* run_end = s + CountPrintableAscii(s, (word_wrap_enabled && word_wrap_eol < text_end) ? word_wrap_eol : text_end);
+        for (; s < run_end; s++)
+        {
+            const int c = (unsigned char)*s;
+            const int glyph_index = (c < index_lookup_size) ? (int)index_lookup[c] : 0xFFFF;
+            const ImFontGlyph* glyph = (glyph_index < dynamic_glyphs_start) ? &Glyphs.Data[glyph_index] : FindGlyph((ImWchar)c); // Glyphs loaded on demand go through FindGlyph() to be tracked
+            if (!glyph)
+                continue;
+            if (c != ' ')
+            {
+                const float x1 = x + glyph->X0 * scale;
+                const float x2 = x + glyph->X1 * scale;
+                if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                {
+                    const float y1 = y + glyph->Y0 * scale;
+                    const float y2 = y + glyph->Y1 * scale;
+                    if (cpu_fine_clip && (x1 < clip_rect.x || y1 < clip_rect.y || x2 > clip_rect.z || y2 > clip_rect.w))
+                        break; // Leave quads that need clipping to the generic path below
+                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = glyph->U0; vtx_write[0].uv.y = glyph->V0;
+                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = glyph->U1; vtx_write[1].uv.y = glyph->V0;
+                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = glyph->U1; vtx_write[2].uv.y = glyph->V1;
+                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = glyph->U0; vtx_write[3].uv.y = glyph->V1;
+                    vtx_write += 4;
+                }
+            }
+            x += glyph->AdvanceX * scale;
+        }
+        if (s >= text_end)
+            break;
+        if (word_wrap_enabled && s >= word_wrap_eol)
+            continue;
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -2590,15 +3670,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 
                     // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                     {
-                        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
-                        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
                         vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
                         vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
                         vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
                         vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
                         vtx_write += 4;
-                        vtx_current_idx += 4;
-                        idx_write += 6;
                     }
                 }
             }
@@ -2607,13 +3683,17 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         x += char_width;
     }
 
+    // Write the indices of the quads
+    static const unsigned int pattern[6] = { 0,1,2, 0,2,3 };
+    ImDrawIdx* idx_write = WriteIndexBlocks(draw_list->_IdxWritePtr, draw_list->_VtxCurrentIdx, pattern, 4, (int)(vtx_write - vtx_begin) / 4);
+
     // Give back unused vertices
     draw_list->VtxBuffer.resize((int)(vtx_write - draw_list->VtxBuffer.Data));
     draw_list->IdxBuffer.resize((int)(idx_write - draw_list->IdxBuffer.Data));
     draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
-    draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size;
+    draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size - draw_list->_VtxCurrentOffset;
 }
 
 //-----------------------------------------------------------------------------
@@ -76,6 +76,23 @@ void ImGui_ImplGlfwGL2_RenderDrawLists(ImDrawData* draw_data)
     glPushMatrix();
     glLoadIdentity();
 
+    // Upload the parts of the font texture changed by glyphs loaded on demand
+    if (io.Fonts->TexDirtyRects.Size > 0 && g_FontTexture)
+    {
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        for (int n = 0; n < io.Fonts->TexDirtyRects.Size; n++)
+        {
+            const ImFontAtlas::DirtyRect& r = io.Fonts->TexDirtyRects[n];
+            glTexSubImage2D(GL_TEXTURE_2D, 0, r.X, r.Y, r.Width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (r.Y * width + r.X) * 4);
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        io.Fonts->TexDirtyRects.clear();
+    }
+
     // Render command lists
     #define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
     for (int n = 0; n < draw_data->CmdListsCount; n++)
@@ -83,13 +100,20 @@ void ImGui_ImplGlfwGL2_RenderDrawLists(ImDrawData* draw_data)
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
         const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
         const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
-        glVertexPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_buffer + OFFSETOF(ImDrawVert, pos)));
-        glTexCoordPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_buffer + OFFSETOF(ImDrawVert, uv)));
-        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_buffer + OFFSETOF(ImDrawVert, col)));
+        unsigned int vtx_offset = (unsigned int)-1;
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->VtxOffset != vtx_offset)
+            {
+                // Draw lists over 64K vertices are split in several vertex offsets (io.RendererHasVtxOffset)
+                vtx_offset = pcmd->VtxOffset;
+                const ImDrawVert* vtx_base = vtx_buffer + vtx_offset;
+                glVertexPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_base + OFFSETOF(ImDrawVert, pos)));
+                glTexCoordPointer(2, GL_FLOAT, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_base + OFFSETOF(ImDrawVert, uv)));
+                glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ImDrawVert), (const GLvoid*)((const char*)vtx_base + OFFSETOF(ImDrawVert, col)));
+            }
             if (pcmd->UserCallback)
             {
                 pcmd->UserCallback(cmd_list, pcmd);
@@ -225,6 +249,7 @@ bool    ImGui_ImplGlfwGL2_Init(GLFWwindow* window, bool install_callbacks)
     io.KeyMap[ImGuiKey_Z] = GLFW_KEY_Z;
 
     io.RenderDrawListsFn = ImGui_ImplGlfwGL2_RenderDrawLists;      // Alternatively you can set this to NULL and call ImGui::GetDrawData() after ImGui::Render() to get the same ImDrawData pointer.
+    io.RendererHasVtxOffset = true;
     io.SetClipboardTextFn = ImGui_ImplGlfwGL2_SetClipboardText;
     io.GetClipboardTextFn = ImGui_ImplGlfwGL2_GetClipboardText;
     io.ClipboardUserData = g_Window;
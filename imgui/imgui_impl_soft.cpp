@@ -0,0 +1,460 @@
+// ImGui software rasterizer binding (no GPU or OpenGL context needed)
+// In this binding, ImTextureID is a pointer to an ImGui_ImplSoft_Texture. Read the FAQ about ImTextureID in imgui.cpp.
+
+// The framebuffer is split in square tiles. Triangles are binned into the tiles they overlap (after clipping with the
+// ImDrawCmd clip rectangle), in submission order, and then the tiles are rasterized in parallel. Since every tile
+// processes its triangles in order, the output does not depend on the number of threads.
+// Coverage is evaluated four pixels at a time with SSE2 (when available), and triangles with a constant color and
+// texture coordinate (the vast majority: filled rectangles, frames, lines...) are blended four pixels at a time too.
+// Other triangles (text, anti-aliased fringes) are shaded one pixel at a time with bilinear texture sampling.
+// Blending follows glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) on all four channels, like the GL2 binding.
+
+// You can copy and use unmodified imgui_impl_* files in your project.
+// If you use this binding you'll need to call 4 functions: ImGui_ImplXXXX_Init(), ImGui_ImplXXXX_NewFrame(), ImGui::Render() and ImGui_ImplXXXX_Shutdown().
+// If you are new to ImGui, see examples/README.txt and documentation at the top of imgui.cpp.
+// https://github.com/ocornut/imgui
+
+#include <imgui.h>
+#include "imgui_internal.h"
+#include "imgui_impl_soft.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMGUI_SOFT_SSE2
+#endif
+
+#define IMGUI_SOFT_TILE_SIZE 64
+
+// A triangle binned into the tiles, with its clipped bounding box in framebuffer pixels (max is exclusive)
+struct ImGui_ImplSoft_Triangle
+{
+    const ImDrawVert*               V[3];
+    const ImGui_ImplSoft_Texture*   Texture;
+    int                             MinX, MinY, MaxX, MaxY;
+};
+
+// Data
+static ImGui_ImplSoft_Texture                   g_FontTexture = { NULL, 0, 0 };
+static ImVector<ImU32>                          g_Framebuffer;
+static int                                      g_FbWidth = 0, g_FbHeight = 0;
+static ImU32                                    g_ClearColor = IM_COL32(0, 0, 0, 255);
+static ImVec2                                   g_Scale = ImVec2(1.0f, 1.0f);
+static double                                   g_RenderTime = 0.0;
+static int                                      g_TilesX = 0, g_TilesY = 0;
+static std::vector<ImGui_ImplSoft_Triangle>     g_Triangles;
+static std::vector<std::vector<int> >           g_Bins;
+static int                                      g_NumThreads = 1;
+
+// Worker pool: the thread calling RenderDrawLists works too
+static std::vector<std::thread>                 g_Threads;
+static std::mutex                               g_Mutex;
+static std::condition_variable                  g_CvStart, g_CvDone;
+static std::atomic<int>                         g_NextTile(0);
+static unsigned int                             g_Job = 0;
+static int                                      g_Busy = 0;
+static bool                                     g_Quit = false;
+
+static inline ImU32 ImGui_ImplSoft_Div255(ImU32 x) { return (x + 128 + ((x + 128) >> 8)) >> 8; }   // exact round(x/255) for x <= 255*255
+
+static inline ImU32 ImGui_ImplSoft_Blend(ImU32 dst, ImU32 src)
+{
+    ImU32 sa = src >> 24, da = 255 - sa, out = 0;
+    for (int c = 0; c < 32; c += 8)
+        out |= ImGui_ImplSoft_Div255(((src >> c) & 0xFF) * sa + ((dst >> c) & 0xFF) * da) << c;
+    return out;
+}
+
+static void ImGui_ImplSoft_Sample(const ImGui_ImplSoft_Texture* tex, float u, float v, float out[4])
+{
+    if (!tex || !tex->Pixels)
+    {
+        out[0] = out[1] = out[2] = out[3] = 255.0f;
+        return;
+    }
+    float fx = u * tex->Width - 0.5f, fy = v * tex->Height - 0.5f;
+    float x0f = floorf(fx), y0f = floorf(fy);
+    float ax = fx - x0f, ay = fy - y0f;
+    int x0 = (int)x0f, y0 = (int)y0f, x1 = x0 + 1, y1 = y0 + 1;
+    x0 = ImClamp(x0, 0, tex->Width - 1); x1 = ImClamp(x1, 0, tex->Width - 1);
+    y0 = ImClamp(y0, 0, tex->Height - 1); y1 = ImClamp(y1, 0, tex->Height - 1);
+    const unsigned char* p00 = tex->Pixels + (y0 * tex->Width + x0) * 4;
+    const unsigned char* p10 = tex->Pixels + (y0 * tex->Width + x1) * 4;
+    const unsigned char* p01 = tex->Pixels + (y1 * tex->Width + x0) * 4;
+    const unsigned char* p11 = tex->Pixels + (y1 * tex->Width + x1) * 4;
+    for (int c = 0; c < 4; c++)
+    {
+        float top = p00[c] + (p10[c] - p00[c]) * ax;
+        float bot = p01[c] + (p11[c] - p01[c]) * ax;
+        out[c] = top + (bot - top) * ay;
+    }
+}
+
+// Shaded color of a pixel: vertex color (0..255 floats) modulated by the texture
+static inline ImU32 ImGui_ImplSoft_Shade(const ImGui_ImplSoft_Texture* tex, float u, float v, const float col[4])
+{
+    float t[4];
+    ImGui_ImplSoft_Sample(tex, u, v, t);
+    ImU32 out = 0;
+    for (int c = 0; c < 4; c++)
+        out |= ((ImU32)(col[c] * t[c] * (1.0f / 255.0f) + 0.5f) & 0xFF) << (c * 8);
+    return out;
+}
+
+static void ImGui_ImplSoft_RasterTriangle(const ImGui_ImplSoft_Triangle& tri, int min_x, int min_y, int max_x, int max_y)
+{
+    const ImDrawVert* v0 = tri.V[0];
+    const ImDrawVert* v1 = tri.V[1];
+    const ImDrawVert* v2 = tri.V[2];
+    ImVec2 p0(v0->pos.x * g_Scale.x, v0->pos.y * g_Scale.y);
+    ImVec2 p1(v1->pos.x * g_Scale.x, v1->pos.y * g_Scale.y);
+    ImVec2 p2(v2->pos.x * g_Scale.x, v2->pos.y * g_Scale.y);
+    float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (area == 0.0f)
+        return;
+    if (area < 0.0f)
+    {
+        ImVec2 tp = p1; p1 = p2; p2 = tp;
+        const ImDrawVert* tv = v1; v1 = v2; v2 = tv;
+        area = -area;
+    }
+
+    // Edge functions E(x,y) = A*x + B*y + C, positive inside. Edge i is opposite to vertex i, so E_i/area is the
+    // barycentric weight of vertex i. Pixels exactly on an edge belong to one side only, to avoid blending twice.
+    const ImVec2* pa[3] = { &p1, &p2, &p0 };
+    const ImVec2* pb[3] = { &p2, &p0, &p1 };
+    float ea[3], eb[3], ec[3];
+    bool inclusive[3];
+    for (int i = 0; i < 3; i++)
+    {
+        ea[i] = -(pb[i]->y - pa[i]->y);
+        eb[i] = pb[i]->x - pa[i]->x;
+        ec[i] = -(ea[i] * pa[i]->x + eb[i] * pa[i]->y);
+        inclusive[i] = ea[i] > 0.0f || (ea[i] == 0.0f && eb[i] > 0.0f);
+    }
+    const float inv_area = 1.0f / area;
+
+    // Constant color and texture coordinate: shade once
+    const bool solid = v0->col == v1->col && v0->col == v2->col && v0->uv.x == v1->uv.x && v0->uv.x == v2->uv.x && v0->uv.y == v1->uv.y && v0->uv.y == v2->uv.y;
+    ImU32 solid_col = 0;
+    if (solid)
+    {
+        float col[4] = { (float)(v0->col & 0xFF), (float)((v0->col >> 8) & 0xFF), (float)((v0->col >> 16) & 0xFF), (float)(v0->col >> 24) };
+        solid_col = ImGui_ImplSoft_Shade(tri.Texture, v0->uv.x, v0->uv.y, col);
+        if ((solid_col >> 24) == 0)
+            return;
+    }
+
+    for (int y = min_y; y < max_y; y++)
+    {
+        ImU32* row = g_Framebuffer.Data + y * g_FbWidth;
+        const float py = y + 0.5f;
+        for (int x = min_x; x < max_x; x += 4)
+        {
+            // Coverage mask of pixels x..x+3
+            int mask;
+            float w[3][4];
+#ifdef IMGUI_SOFT_SSE2
+            const __m128 px = _mm_add_ps(_mm_set1_ps(x + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int i = 0; i < 3; i++)
+            {
+                __m128 wi = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ea[i]), px), _mm_set1_ps(eb[i] * py + ec[i]));
+                inside = _mm_and_ps(inside, inclusive[i] ? _mm_cmpge_ps(wi, _mm_setzero_ps()) : _mm_cmpgt_ps(wi, _mm_setzero_ps()));
+                _mm_storeu_ps(w[i], wi);
+            }
+            mask = _mm_movemask_ps(inside);
+#else
+            mask = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                bool in = true;
+                for (int i = 0; i < 3; i++)
+                {
+                    w[i][k] = ea[i] * (x + k + 0.5f) + (eb[i] * py + ec[i]);
+                    in = in && (inclusive[i] ? w[i][k] >= 0.0f : w[i][k] > 0.0f);
+                }
+                if (in)
+                    mask |= 1 << k;
+            }
+#endif
+            if (x + 4 > max_x)
+                mask &= (1 << (max_x - x)) - 1;
+            if (!mask)
+                continue;
+
+            if (solid)
+            {
+#ifdef IMGUI_SOFT_SSE2
+                if (mask == 0xF)
+                {
+                    // out = (src * sa + dst * (255 - sa)) / 255 on all channels of four pixels
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128i sa = _mm_set1_epi16((short)(solid_col >> 24));
+                    const __m128i da = _mm_set1_epi16((short)(255 - (solid_col >> 24)));
+                    const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)solid_col), zero);
+                    const __m128i src_sa = _mm_mullo_epi16(src, sa);
+                    const __m128i c128 = _mm_set1_epi16(128);
+                    __m128i dst = _mm_loadu_si128((const __m128i*)(row + x));
+                    __m128i lo = _mm_add_epi16(_mm_add_epi16(src_sa, _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), da)), c128);
+                    __m128i hi = _mm_add_epi16(_mm_add_epi16(src_sa, _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), da)), c128);
+                    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+                    _mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(lo, hi));
+                    continue;
+                }
+#endif
+                for (int k = 0; k < 4; k++)
+                    if (mask & (1 << k))
+                        row[x + k] = ImGui_ImplSoft_Blend(row[x + k], solid_col);
+                continue;
+            }
+
+            for (int k = 0; k < 4; k++)
+            {
+                if (!(mask & (1 << k)))
+                    continue;
+                const float l0 = w[0][k] * inv_area, l1 = w[1][k] * inv_area, l2 = 1.0f - l0 - l1;
+                const float u = l0 * v0->uv.x + l1 * v1->uv.x + l2 * v2->uv.x;
+                const float v = l0 * v0->uv.y + l1 * v1->uv.y + l2 * v2->uv.y;
+                float col[4];
+                for (int c = 0; c < 4; c++)
+                    col[c] = l0 * ((v0->col >> (c * 8)) & 0xFF) + l1 * ((v1->col >> (c * 8)) & 0xFF) + l2 * ((v2->col >> (c * 8)) & 0xFF);
+                row[x + k] = ImGui_ImplSoft_Blend(row[x + k], ImGui_ImplSoft_Shade(tri.Texture, u, v, col));
+            }
+        }
+    }
+}
+
+static void ImGui_ImplSoft_RasterTiles()
+{
+    int tile;
+    while ((tile = g_NextTile.fetch_add(1)) < g_TilesX * g_TilesY)
+    {
+        const int tx0 = (tile % g_TilesX) * IMGUI_SOFT_TILE_SIZE, ty0 = (tile / g_TilesX) * IMGUI_SOFT_TILE_SIZE;
+        const int tx1 = ImMin(tx0 + IMGUI_SOFT_TILE_SIZE, g_FbWidth), ty1 = ImMin(ty0 + IMGUI_SOFT_TILE_SIZE, g_FbHeight);
+        for (int y = ty0; y < ty1; y++)
+            for (int x = tx0; x < tx1; x++)
+                g_Framebuffer.Data[y * g_FbWidth + x] = g_ClearColor;
+
+        const std::vector<int>& bin = g_Bins[tile];
+        for (size_t i = 0; i < bin.size(); i++)
+        {
+            const ImGui_ImplSoft_Triangle& tri = g_Triangles[bin[i]];
+            ImGui_ImplSoft_RasterTriangle(tri, ImMax(tri.MinX, tx0), ImMax(tri.MinY, ty0), ImMin(tri.MaxX, tx1), ImMin(tri.MaxY, ty1));
+        }
+    }
+}
+
+static void ImGui_ImplSoft_Worker(unsigned int job)
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(g_Mutex);
+            g_CvStart.wait(lock, [&]{ return g_Quit || g_Job != job; });
+            if (g_Quit)
+                return;
+            job = g_Job;
+        }
+        ImGui_ImplSoft_RasterTiles();
+        {
+            std::lock_guard<std::mutex> lock(g_Mutex);
+            if (--g_Busy == 0)
+                g_CvDone.notify_one();
+        }
+    }
+}
+
+// This is the main rendering function that you have to implement and provide to ImGui (via setting up 'RenderDrawListsFn' in the ImGuiIO structure)
+// The atlas pixels are reallocated when the atlas is built again (fonts changed, DPI change, atlas loaded from the disk cache) and the
+// texture id is reset, so the font texture is fetched again every frame instead of only in Init()
+static void ImGui_ImplSoft_UpdateFontTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int tex_width, tex_height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &tex_width, &tex_height);
+    g_FontTexture.Pixels = pixels;
+    g_FontTexture.Width = tex_width;
+    g_FontTexture.Height = tex_height;
+    io.Fonts->TexID = (void*)&g_FontTexture;
+}
+
+void ImGui_ImplSoft_RenderDrawLists(ImDrawData* draw_data)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    ImGuiIO& io = ImGui::GetIO();
+    if (g_FbWidth == 0 || g_FbHeight == 0)
+        return;
+    g_Scale = io.DisplayFramebufferScale;
+    draw_data->ScaleClipRects(io.DisplayFramebufferScale);
+
+    // The font texture points to the atlas RGBA pixels, where glyphs loaded on demand are already written
+    ImGui_ImplSoft_UpdateFontTexture();
+    io.Fonts->TexDirtyRects.clear();
+
+    // Bin the triangles into the tiles they overlap
+    g_TilesX = (g_FbWidth + IMGUI_SOFT_TILE_SIZE - 1) / IMGUI_SOFT_TILE_SIZE;
+    g_TilesY = (g_FbHeight + IMGUI_SOFT_TILE_SIZE - 1) / IMGUI_SOFT_TILE_SIZE;
+    if ((int)g_Bins.size() != g_TilesX * g_TilesY)
+        g_Bins.resize(g_TilesX * g_TilesY);
+    for (size_t i = 0; i < g_Bins.size(); i++)
+        g_Bins[i].clear();
+    g_Triangles.clear();
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
+        const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+            {
+                pcmd->UserCallback(cmd_list, pcmd);
+                idx_buffer += pcmd->ElemCount;
+                continue;
+            }
+            const int clip_x0 = ImMax((int)pcmd->ClipRect.x, 0), clip_y0 = ImMax((int)pcmd->ClipRect.y, 0);
+            const int clip_x1 = ImMin((int)pcmd->ClipRect.z, g_FbWidth), clip_y1 = ImMin((int)pcmd->ClipRect.w, g_FbHeight);
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount && clip_x0 < clip_x1 && clip_y0 < clip_y1; i += 3)
+            {
+                ImGui_ImplSoft_Triangle tri;
+                tri.Texture = (const ImGui_ImplSoft_Texture*)pcmd->TextureId;
+                float bb_x0 = FLT_MAX, bb_y0 = FLT_MAX, bb_x1 = -FLT_MAX, bb_y1 = -FLT_MAX;
+                for (int k = 0; k < 3; k++)
+                {
+                    tri.V[k] = &vtx_buffer[pcmd->VtxOffset + idx_buffer[i + k]];
+                    bb_x0 = ImMin(bb_x0, tri.V[k]->pos.x * g_Scale.x); bb_x1 = ImMax(bb_x1, tri.V[k]->pos.x * g_Scale.x);
+                    bb_y0 = ImMin(bb_y0, tri.V[k]->pos.y * g_Scale.y); bb_y1 = ImMax(bb_y1, tri.V[k]->pos.y * g_Scale.y);
+                }
+                tri.MinX = ImMax((int)floorf(bb_x0), clip_x0); tri.MaxX = ImMin((int)ceilf(bb_x1), clip_x1);
+                tri.MinY = ImMax((int)floorf(bb_y0), clip_y0); tri.MaxY = ImMin((int)ceilf(bb_y1), clip_y1);
+                if (tri.MinX >= tri.MaxX || tri.MinY >= tri.MaxY)
+                    continue;
+                const int index = (int)g_Triangles.size();
+                g_Triangles.push_back(tri);
+                for (int ty = tri.MinY / IMGUI_SOFT_TILE_SIZE; ty <= (tri.MaxY - 1) / IMGUI_SOFT_TILE_SIZE; ty++)
+                    for (int tx = tri.MinX / IMGUI_SOFT_TILE_SIZE; tx <= (tri.MaxX - 1) / IMGUI_SOFT_TILE_SIZE; tx++)
+                        g_Bins[ty * g_TilesX + tx].push_back(index);
+            }
+            idx_buffer += pcmd->ElemCount;
+        }
+    }
+
+    // Rasterize the tiles in parallel
+    const int num_threads = ImMin(g_NumThreads, g_TilesX * g_TilesY);
+    while ((int)g_Threads.size() < num_threads - 1)
+        g_Threads.push_back(std::thread(ImGui_ImplSoft_Worker, g_Job));
+    {
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        g_NextTile = 0;
+        g_Busy = (int)g_Threads.size();
+        g_Job++;
+    }
+    g_CvStart.notify_all();
+    ImGui_ImplSoft_RasterTiles();
+    {
+        std::unique_lock<std::mutex> lock(g_Mutex);
+        g_CvDone.wait(lock, []{ return g_Busy == 0; });
+    }
+
+    g_RenderTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void ImGui_ImplSoft_SetFramebufferSize(int width, int height)
+{
+    g_FbWidth = ImMax(width, 0);
+    g_FbHeight = ImMax(height, 0);
+    g_Framebuffer.resize(g_FbWidth * g_FbHeight);
+    for (int i = 0; i < g_Framebuffer.Size; i++)
+        g_Framebuffer[i] = g_ClearColor;
+}
+
+void ImGui_ImplSoft_SetClearColor(ImU32 col)
+{
+    g_ClearColor = col;
+}
+
+const unsigned char* ImGui_ImplSoft_GetFramebuffer(int* width, int* height)
+{
+    if (width) *width = g_FbWidth;
+    if (height) *height = g_FbHeight;
+    return (const unsigned char*)g_Framebuffer.Data;
+}
+
+double ImGui_ImplSoft_GetRenderTime()
+{
+    return g_RenderTime;
+}
+
+bool ImGui_ImplSoft_SaveScreenshot(const char* filename)
+{
+    FILE* f = fopen(filename, "wb");
+    if (!f)
+        return false;
+    fprintf(f, "P6\n%d %d\n255\n", g_FbWidth, g_FbHeight);
+    const unsigned char* p = (const unsigned char*)g_Framebuffer.Data;
+    for (int i = 0; i < g_FbWidth * g_FbHeight; i++, p += 4)
+        fwrite(p, 1, 3, f);
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+bool ImGui_ImplSoft_Init(int width, int height, int num_threads)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoft_UpdateFontTexture();
+
+    g_NumThreads = num_threads > 0 ? num_threads : ImMax((int)std::thread::hardware_concurrency(), 1);
+    ImGui_ImplSoft_SetFramebufferSize(width, height);
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+    io.RenderDrawListsFn = ImGui_ImplSoft_RenderDrawLists;      // Alternatively you can set this to NULL and call ImGui::GetDrawData() after ImGui::Render() to get the same ImDrawData pointer.
+    io.RendererHasVtxOffset = true;
+    return true;
+}
+
+void ImGui_ImplSoft_Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        g_Quit = true;
+    }
+    g_CvStart.notify_all();
+    for (size_t i = 0; i < g_Threads.size(); i++)
+        g_Threads[i].join();
+    g_Threads.clear();
+    g_Quit = false;
+
+    ImGui::GetIO().Fonts->TexID = 0;
+    g_FontTexture.Pixels = NULL;
+    g_Framebuffer.clear();
+    g_Triangles.clear();
+    g_Bins.clear();
+    g_FbWidth = g_FbHeight = 0;
+    ImGui::Shutdown();
+}
+
+void ImGui_ImplSoft_NewFrame(float delta_time)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    // Setup display size and time step
+    io.DisplaySize = ImVec2((float)g_FbWidth / io.DisplayFramebufferScale.x, (float)g_FbHeight / io.DisplayFramebufferScale.y);
+    io.DeltaTime = delta_time > 0.0f ? delta_time : 1.0f / 60.0f;
+
+    // Start the frame (the draw commands take the texture id of the atlas)
+    ImGui_ImplSoft_UpdateFontTexture();
+    ImGui::NewFrame();
+}
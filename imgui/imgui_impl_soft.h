@@ -0,0 +1,31 @@
+// ImGui software rasterizer binding (no GPU or OpenGL context needed)
+// Renders ImDrawData into a 32-bit RGBA framebuffer in memory, split in tiles that are rasterized in parallel on a pool
+// of threads. Useful for screenshots and frame time measurements on headless machines.
+// In this binding, ImTextureID is a pointer to an ImGui_ImplSoft_Texture. The font atlas texture is set up by ImGui_ImplSoft_Init() and fetched again every frame, so the atlas can be rebuilt at any time.
+
+// If you use this binding you'll need to call 4 functions: ImGui_ImplSoft_Init(), ImGui_ImplSoft_NewFrame(), ImGui::Render() and ImGui_ImplSoft_Shutdown().
+// Inputs (mouse, keyboard) are not handled: set them in ImGuiIO yourself before calling ImGui_ImplSoft_NewFrame().
+
+// A texture for the software renderer. Pixels are 32-bit RGBA, non-premultiplied, row-major.
+struct ImGui_ImplSoft_Texture
+{
+    const unsigned char*    Pixels;
+    int                     Width;
+    int                     Height;
+};
+
+IMGUI_API bool                  ImGui_ImplSoft_Init(int width, int height, int num_threads = 0);    // num_threads = 0: one thread per core
+IMGUI_API void                  ImGui_ImplSoft_Shutdown();
+IMGUI_API void                  ImGui_ImplSoft_NewFrame(float delta_time);
+IMGUI_API void                  ImGui_ImplSoft_RenderDrawLists(ImDrawData* draw_data);
+
+// Resize the framebuffer (the display size follows in the next NewFrame) and set the color it is cleared to before rendering.
+IMGUI_API void                  ImGui_ImplSoft_SetFramebufferSize(int width, int height);
+IMGUI_API void                  ImGui_ImplSoft_SetClearColor(ImU32 col);
+
+// Access the last rendered frame (RGBA, width*height*4 bytes) and the time it took to render it, in milliseconds.
+IMGUI_API const unsigned char*  ImGui_ImplSoft_GetFramebuffer(int* width, int* height);
+IMGUI_API double                ImGui_ImplSoft_GetRenderTime();
+
+// Save the last rendered frame as a binary PPM image. Returns false on error.
+IMGUI_API bool                  ImGui_ImplSoft_SaveScreenshot(const char* filename);
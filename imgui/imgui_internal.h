@@ -15,6 +15,12 @@
 #include <stdio.h>      // FILE*
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 
+// SSE2 code paths for the tessellation in ImDrawList (always available on x86-64). Define IMGUI_DISABLE_SSE in imconfig.h to build the scalar code only.
+#if !defined(IMGUI_DISABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (push)
 #pragma warning (disable: 4251) // class 'xxx' needs to have dll-interface to be used by clients of struct 'xxx' // when IMGUI_API is set to__declspec(dllexport)
@@ -42,6 +48,7 @@ struct ImGuiMouseCursorData;
 struct ImGuiPopupRef;
 struct ImGuiWindow;
 struct ImGuiWindowSettings;
+struct ImGuiSettingsWriter;
 
 typedef int ImGuiLayoutType;        // enum: horizontal or vertical             // enum ImGuiLayoutType_
 typedef int ImGuiButtonFlags;       // flags: for ButtonEx(), ButtonBehavior()  // enum ImGuiButtonFlags_
@@ -89,6 +96,7 @@ IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, cons
 
 // Helpers: Misc
 IMGUI_API ImU32         ImHash(const void* data, int data_size, ImU32 seed = 0);    // Pass data_size==0 for zero-terminated strings
+IMGUI_API ImU64         ImHash64(const void* data, int data_size, ImU64 seed = 0);  // Faster on long data, no zero-terminated strings or ### handling
 IMGUI_API void*         ImFileLoadToMemory(const char* filename, const char* file_open_mode, int* out_file_size = NULL, int padding_bytes = 0);
 IMGUI_API FILE*         ImFileOpen(const char* filename, const char* file_open_mode);
 static inline bool      ImCharIsSpace(int c)            { return c == ' ' || c == '\t' || c == 0x3000; }
@@ -414,6 +422,53 @@ struct ImGuiPopupRef
     ImGuiPopupRef(ImGuiID id, ImGuiWindow* parent_window, ImGuiID parent_menu_set, const ImVec2& mouse_pos) { PopupId = id; Window = NULL; ParentWindow = parent_window; ParentMenuSet = parent_menu_set; MousePosOnOpen = mouse_pos; }
 };
 
+// Measurement kept by ImGuiTextSizeCache (a POD, copied around with memcpy() by ImVector)
+struct ImGuiTextSizeCacheEntry
+{
+    ImU64           Hash;           // Hash of the text contents (64-bit so that the text doesn't need to be kept for comparison)
+    int             TextLen;
+    const ImFont*   Font;
+    int             FontGeneration; // == Font->ContainerAtlas->Generation at the time of the measurement
+    float           FontSize;
+    float           WrapWidth;
+    ImVec2          Size;           // Result of CalcTextSize()
+    int             WrapEolsOffset; // Ends of the word-wrapped lines in ImGuiTextSizeCache::WrapEols, see ImFont::CalcTextSizeA()
+    int             WrapEolsCount;
+    int             HashNext;       // Next entry in the same bucket, -1 if last
+    int             LruPrev;        // Next more recently used entry, -1 if first
+    int             LruNext;        // Next less recently used entry, -1 if last
+};
+
+// Least recently used cache of CalcTextSize() results (see io.TextSizeCacheCapacity)
+struct IMGUI_API ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Entries;
+    ImVector<int>   Buckets;        // First entry of each hash chain, -1 if empty
+    ImVector<int>   WrapEols;       // Ends of the word-wrapped lines of all the entries, appended to as they are measured
+    ImVector<int>   WrapEolsSpare;  // Swapped with WrapEols when the evicted entries are dropped from it
+    int             WrapEolsLive;   // Number of values in WrapEols that belong to live entries
+    int             Capacity;
+    int             LruFirst;       // Most recently used entry
+    int             LruLast;        // Least recently used entry, evicted first
+    int             Hits, Misses;   // Lookups done by CalcTextSize() during the current frame
+    int             HitsLastFrame, MissesLastFrame;
+
+    ImGuiTextSizeCache()            { Capacity = 0; WrapEolsLive = 0; LruFirst = LruLast = -1; Hits = Misses = HitsLastFrame = MissesLastFrame = 0; }
+    ~ImGuiTextSizeCache()           { Clear(); }
+    void                            Clear();
+    ImGuiTextSizeCacheEntry*        Find(ImU64 hash, int text_len, const ImFont* font, float font_size, float wrap_width);
+    ImGuiTextSizeCacheEntry*        Add(ImU64 hash, int text_len, const ImFont* font, float font_size, float wrap_width, int capacity);
+    void                            CompactWrapEols();
+};
+
+// Set the allocation tag of the calling thread for the duration of a scope (see ImGuiMemTag_)
+struct ImGuiMemTagScope
+{
+    ImGuiMemTag             BackupTag;
+    ImGuiMemTagScope(ImGuiMemTag tag)   { BackupTag = ImGui::SetMemTag(tag); }
+    ~ImGuiMemTagScope()                 { ImGui::SetMemTag(BackupTag); }
+};
+
 // Main state for ImGui
 struct ImGuiContext
 {
@@ -478,8 +533,14 @@ struct ImGuiContext
     // Render
     ImDrawData              RenderDrawData;                     // Main ImDrawData instance to pass render information to the user
     ImVector<ImDrawList*>   RenderDrawLists[3];
+    ImVector<ImDrawList*>   MergedDrawLists;                    // Storage for io.OptMergeDrawCommands, reused across frames
+    ImVector<ImDrawList*>   MergedDrawListsActive;
     float                   ModalWindowDarkeningRatio;
     ImDrawList              OverlayDrawList;                    // Optional software render of mouse cursors, if io.MouseDrawCursor is set + a few debug overlays
+    size_t                  DrawListsMemory;                    // Bytes allocated by the window draw lists, summed on every NewFrame() after the trimming (see io.DrawListShrinkFrames)
+    size_t                  DrawListsMemoryBeforeTrim;          // Same, before and after the last time some memory was given back
+    size_t                  DrawListsMemoryAfterTrim;
+    int                     DrawListsTrimFrame;                 // Frame of the last time some memory was given back (-1 = never)
     ImGuiMouseCursor        MouseCursor;
     ImGuiMouseCursorData    MouseCursorData[ImGuiMouseCursor_Count_];
 
@@ -497,11 +558,16 @@ struct ImGuiContext
     ImVec2                  ScrollbarClickDeltaToGrabCenter;    // Distance between mouse and center of grab box, normalized in parent space. Use storage?
     int                     TooltipOverrideCount;
     ImVector<char>          PrivateClipboard;                   // If no custom clipboard handler is defined
+    ImGuiTextSizeCache      TextSizeCache;                      // Results of CalcTextSize(), reused across frames
+    bool                    DrawingInParallel;                  // Draw lists are being recorded by several threads (see RenderDocksParallel() in imgui_dock.h): CalcTextSize() skips the cache and ImFont::FindGlyph() locks
+    ImVector<ImDrawVert>    DeIndexVtxBuffer;                   // Scratch buffer of ImDrawData::DeIndexAllBuffers(), kept from one frame to the next
     ImVec2                  OsImePosRequest, OsImePosSet;       // Cursor position request & last passed to the OS Input Method Editor
 
     // Settings
     float                          SettingsDirtyTimer;          // Save .ini Settings on disk when time reaches zero
     ImVector<ImGuiWindowSettings>  SettingsWindows;             // .ini settings for ImGuiWindow
+    ImGuiStorage                   SettingsWindowsIndex;        // Index in SettingsWindows + 1, by window ID
+    ImGuiSettingsWriter*           SettingsWriter;              // Background thread writing the .ini file (started on the first save from NewFrame)
     ImVector<ImGuiSettingsHandler> SettingsHandlers;            // List of .ini settings handlers
 
     // Logging
@@ -530,6 +596,7 @@ struct ImGuiContext
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountRendered = -1;
+        WindowsById.SetUseHashTable(true);   // Looked up by every Begin()/FindWindowByName()
         CurrentWindow = NULL;
         NavWindow = NULL;
         HoveredWindow = NULL;
@@ -573,14 +640,19 @@ struct ImGuiContext
         DragSpeedScaleFast = 10.0f;
         ScrollbarClickDeltaToGrabCenter = ImVec2(0.0f, 0.0f);
         TooltipOverrideCount = 0;
+        DrawingInParallel = false;
         OsImePosRequest = OsImePosSet = ImVec2(-1.0f, -1.0f);
 
         ModalWindowDarkeningRatio = 0.0f;
         OverlayDrawList._OwnerName = "##Overlay"; // Give it a name for debugging
+        DrawListsMemory = DrawListsMemoryBeforeTrim = DrawListsMemoryAfterTrim = 0;
+        DrawListsTrimFrame = -1;
         MouseCursor = ImGuiMouseCursor_Arrow;
         memset(MouseCursorData, 0, sizeof(MouseCursorData));
 
         SettingsDirtyTimer = 0.0f;
+        SettingsWindowsIndex.SetUseHashTable(true);
+        SettingsWriter = NULL;
 
         LogEnabled = false;
         LogFile = NULL;
@@ -804,6 +876,10 @@ namespace ImGui
 
     IMGUI_API void          Initialize();
 
+    IMGUI_API void          MemTagTrackAlloc(void* ptr, size_t sz, ImGuiMemTag tag);   // Account for memory not allocated with MemAlloc() (e.g. STL allocators)
+    IMGUI_API void          MemTagTrackFree(void* ptr);
+    IMGUI_API void          MemTagsNewFrame();
+
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(ImGuiID type_id);
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
@@ -888,6 +964,7 @@ namespace ImGui
     IMGUI_API void          TreePushRawID(ImGuiID id);
 
     IMGUI_API void          PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size);
+    IMGUI_API void          PlotMinMaxEx(ImGuiPlotType plot_type, const char* label, const ImGuiPlotMinMax& values, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size);
 
     IMGUI_API int           ParseFormatPrecision(const char* fmt, int default_value);
     IMGUI_API float         RoundScalar(float value, int decimal_precision);
@@ -905,6 +982,10 @@ IMGUI_API void              ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtl
 IMGUI_API void              ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent); 
 IMGUI_API void              ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* spc);
 IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename);
+IMGUI_API bool              ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename);
+IMGUI_API void              ImFontAtlasBuildInitDynamicGlyphs(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasBuildClearDynamicGlyphs(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
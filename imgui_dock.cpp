@@ -29,18 +29,99 @@
 #include "imgui_widgets.h"
 #include <imgui_impl_glfw.h>
 #include <unordered_map>
+#include <new>
 #include <algorithm>
 #include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace ImGui;
 
+// Allocator for the dock hash tables. The tables are static and may
+// outlive the ImGui context, so they use malloc/free directly and
+// only report to the DockMap allocation statistics.
+template <typename T> struct DockMapAllocator{
+  typedef T value_type;
+  DockMapAllocator() = default;
+  template <typename U> DockMapAllocator(const DockMapAllocator<U>&){}
+  T* allocate(size_t n){
+    T* ptr = (T*) malloc(n * sizeof(T));
+    if (!ptr) throw std::bad_alloc();
+    MemTagTrackAlloc(ptr,n * sizeof(T),ImGuiMemTag_DockMap);
+    return ptr;
+  }
+  void deallocate(T* ptr, size_t){
+    MemTagTrackFree(ptr);
+    free(ptr);
+  }
+};
+template <typename T, typename U> bool operator==(const DockMapAllocator<T>&, const DockMapAllocator<U>&){ return true;}
+template <typename T, typename U> bool operator!=(const DockMapAllocator<T>&, const DockMapAllocator<U>&){ return false;}
+template <typename K> using DockMap = unordered_map<K,Dock*,std::hash<K>,std::equal_to<K>,DockMapAllocator<std::pair<const K,Dock*>>>;
+
 // Dock context declarations
 static Dock *currentdock = nullptr; // currently open dock (between BeginDock and EndDock)
-static unordered_map<string,Dock*> dockht = {}; // global dock hash table (string key)
-static unordered_map<ImGuiWindow*,Dock*> dockwin = {}; // global dock hash table (window key)
+static DockMap<string> dockht = {}; // global dock hash table (string key)
+static DockMap<ImGuiWindow*> dockwin = {}; // global dock hash table (window key)
 static Dock *FindHoveredDock(int type = -1); // find the container hovered by the mouse
 static void placeWindow(ImGuiWindow* base,ImGuiWindow* moved,int idelta); // place a window relative to another in the window stack
 static void killDock(Dock *dd); // erase the dock from the context and delete the object
+static bool isWindowInvisible(ImGuiWindow* window); // true if the window is off-screen or covered by an opaque window
+
+// Dock event buffer
+static const int DockEventBufferSize = 256; // size of the ring buffer
+static DockEvent dockevents[DockEventBufferSize] = {}; // ring buffer of dock events
+static int dockevents_first = 0; // position of the oldest event in the buffer
+static int dockevents_count = 0; // number of events in the buffer
+static int dockevents_dropped = 0; // number of events overwritten before being polled
+static unsigned int docklayout_generation = 0; // layout generation
+static int docklayout_frame = -1; // last frame in which the layout generation was bumped
+static void pushDockEvent(DockEvent::Type_ type, Dock *dd, Dock *dpar=nullptr, const char *label=nullptr); // record a new event
+
+// Dock command queue (requests from other threads)
+struct DockCommand{
+  enum Type_{Type_None,Type_Open,Type_Close};
+  Type_ type = Type_None; // type of command
+  Dock::Drop_ iedge = Dock::Drop_None; // edge for opening
+  char label[128] = {}; // label of the dock
+  char target[128] = {}; // label of the target container
+  int retries = 0; // number of frames the command has been deferred
+};
+enum DockCommandResult_{DockCommand_Done,DockCommand_Defer,DockCommand_Reject};
+static const int DockQueueMaxDeferred = 256; // maximum number of deferred commands
+static const int DockQueueMaxRetries = 600; // frames a command is retried before it is rejected
+static LockFreeQueue<DockCommand,256> dockqueue; // commands pushed by any thread
+static ImVector<DockCommand> dockqueue_deferred = {}; // commands that could not run yet
+static int dockqueue_frame = -1; // last frame in which the queue was processed
+static bool pushDockCommand(DockCommand::Type_ type, const char* label, const char* target, Dock::Drop_ iedge); // push a command
+static DockCommandResult_ runDockCommand(const DockCommand &cmd); // run a command (done, deferred or rejected)
+static void rejectDockCommand(const DockCommand &cmd); // record that a command was rejected
+static void processDockQueue(); // drain the command queue, once per frame
+
+// Parallel dock drawing
+struct DockDrawRequest{
+  DockDrawCallback fn = nullptr; // drawing callback
+  void *user_data = nullptr; // user data for the callback
+  ImGuiWindow *window = nullptr; // window where the drawing is merged
+  DockDrawInfo info = {}; // information passed to the callback
+  ImDrawList *drawl = nullptr; // draw list where the callback records
+};
+static ImVector<DockDrawRequest> dockdraw = {}; // drawing requests in this frame
+static ImVector<ImDrawList*> dockdraw_lists = {}; // draw lists for the requests (reused between frames)
+static std::vector<std::thread> dockdraw_threads; // worker threads
+static std::mutex dockdraw_mutex; // protects the job variables below
+static std::condition_variable dockdraw_cv_start; // workers wait for a new job
+static std::condition_variable dockdraw_cv_done; // the main thread waits for the workers
+static std::atomic<int> dockdraw_next(0); // next request to be drawn
+static unsigned int dockdraw_job = 0; // job counter (a new value starts the workers)
+static int dockdraw_busy = 0; // number of workers running the current job
+static int dockdraw_nworkers = 0; // workers that take part in the current job (the rest exit)
+static bool dockdraw_quit = false; // the workers exit
+static void runDockDrawRequests(); // run requests until none are left
+static void dockDrawWorker(int index, unsigned int job); // main loop of the worker threads (index in the pool, job = last job seen)
+static void appendDrawList(ImDrawList *dst, ImDrawList *src); // append src at the end of dst
 
 //xx// Dock context methods //xx//
 
@@ -96,6 +177,8 @@ static void placeWindow(ImGuiWindow* base,ImGuiWindow* moved,int idelta){
 static void killDock(Dock *dd){
   ImGuiContext *g = GetCurrentContext();
 
+  if (dd->automatic)
+    pushDockEvent(DockEvent::Type_AutomaticKilled,dd,dd->parent);
   dockht.erase(string(dd->label));
   if (dd->window){
     if (dd->automatic){
@@ -117,6 +200,277 @@ static void killDock(Dock *dd){
   delete dd;
 }
 
+static bool isWindowInvisible(ImGuiWindow* window){
+  ImGuiContext *g = GetCurrentContext();
+  if (!window) return false;
+
+  // completely outside the display
+  ImRect rect = window->Rect();
+  ImRect display(ImVec2(0.f,0.f),g->IO.DisplaySize);
+  if (!display.Overlaps(rect))
+    return true;
+  rect.ClipWith(display);
+
+  // covered by an opaque window above it in the stack
+  for (int i = g->Windows.Size-1; i >= 0; i--){
+    ImGuiWindow *above = g->Windows[i];
+    if (above == window)
+      break;
+    if (!above->Active && !above->WasActive)
+      continue;
+    if (above->Collapsed || above->Flags & (ImGuiWindowFlags_ChildWindow|ImGuiWindowFlags_Tooltip))
+      continue;
+    if (above->WindowRounding > window->WindowRounding)
+      continue;
+    auto it = dockwin.find(above);
+    if (it != dockwin.end() && it->second){
+      // root containers and containers with tabs have a transparent background
+      Dock *dd = it->second;
+      if (dd->type == Dock::Type_Root || dd->hidden || dd->dockflags & Dock::DockFlags_Transparent)
+        continue;
+      if (dd->type == Dock::Type_Container && dd->currenttab)
+        continue;
+    }
+    // docked or not, a translucent background lets the window behind show
+    if (g->Style.Colors[ImGuiCol_WindowBg].w < 1.f || g->Style.Alpha < 1.f)
+      continue;
+    ImRect arect = above->Rect();
+    if (arect.Min.x <= rect.Min.x && arect.Min.y <= rect.Min.y && 
+        arect.Max.x >= rect.Max.x && arect.Max.y >= rect.Max.y)
+      return true;
+  }
+  return false;
+}
+
+static void pushDockEvent(DockEvent::Type_ type, Dock *dd, Dock *dpar/*=nullptr*/, const char *label/*=nullptr*/){
+  if (!dd && !label) return;
+  int frame = GetFrameCount();
+
+  // bump the layout generation, once-per-frame layout changed event
+  if (type != DockEvent::Type_TabActivated && type != DockEvent::Type_LayoutChanged &&
+      type != DockEvent::Type_OpenRejected && type != DockEvent::Type_CloseRejected){
+    docklayout_generation++;
+    if (docklayout_frame != frame){
+      docklayout_frame = frame;
+      pushDockEvent(DockEvent::Type_LayoutChanged,dd,dpar);
+    }
+  }
+
+  // overwrite the oldest event if the buffer is full
+  if (dockevents_count == DockEventBufferSize){
+    dockevents_first = (dockevents_first + 1) % DockEventBufferSize;
+    dockevents_count--;
+    dockevents_dropped++;
+  }
+  DockEvent *ev = &dockevents[(dockevents_first + dockevents_count) % DockEventBufferSize];
+  dockevents_count++;
+
+  ev->type = type;
+  ev->dock = dd;
+  ev->parent = dpar;
+  ev->id = ImHash(dd ? dd->label : label,0);
+  ev->frame = frame;
+  ev->generation = docklayout_generation;
+}
+
+static bool pushDockCommand(DockCommand::Type_ type, const char* label, const char* target, Dock::Drop_ iedge){
+  DockCommand cmd;
+  if (!label || strlen(label) >= IM_ARRAYSIZE(cmd.label)) return false;
+  if (target && strlen(target) >= IM_ARRAYSIZE(cmd.target)) return false;
+  cmd.type = type;
+  cmd.iedge = iedge;
+  strcpy(cmd.label,label);
+  if (target)
+    strcpy(cmd.target,target);
+  return dockqueue.push(cmd);
+}
+
+static DockCommandResult_ runDockCommand(const DockCommand &cmd){
+  auto it = dockht.find(string(cmd.label));
+  Dock *dd = (it != dockht.end()) ? it->second : nullptr;
+
+  if (cmd.type == DockCommand::Type_Close){
+    if (!dd) return DockCommand_Done;
+    if (dd->status == Dock::Status_Docked)
+      dd->closeDock();
+    else if (dd->status != Dock::Status_Closed){
+      pushDockEvent(DockEvent::Type_Closed,dd);
+      dd->status = Dock::Status_Closed;
+    }
+    if (dd->p_open)
+      *(dd->p_open) = false;
+  } else if (cmd.type == DockCommand::Type_Open){
+    it = dockht.find(string(cmd.target));
+    Dock *dcont = (it != dockht.end()) ? it->second : nullptr;
+    if (!dcont) return DockCommand_Defer;
+    if (dcont->type != Dock::Type_Root && dcont->type != Dock::Type_Container) return DockCommand_Reject;
+
+    // an edge of a container needs the container to be docked
+    // somewhere; a root container takes only edges
+    bool astab = (cmd.iedge == Dock::Drop_Tab || cmd.iedge == Dock::Drop_None);
+    if (dcont->type == Dock::Type_Container && !astab && dcont->status != Dock::Status_Docked)
+      return DockCommand_Reject;
+    if (dcont->type == Dock::Type_Root && cmd.iedge == Dock::Drop_None)
+      return DockCommand_Reject;
+
+    // create the dock if it does not exist
+    if (!dd){
+      ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
+      dd = new Dock;
+      IM_ASSERT(dd);
+      dd->label = ImStrdup(cmd.label);
+      dockht[string(dd->label)] = dd;
+      dd->type = Dock::Type_Dock;
+    }
+    if (dd->status == Dock::Status_Docked || dd == dcont) return DockCommand_Done;
+
+    if (dcont->type == Dock::Type_Container && astab){
+      dcont->newDock(dd,-1);
+      dd->control_window_this_frame = true;
+      dd->showTabWindow(dcont,dd->flags & ImGuiWindowFlags_NoResize);
+    } else {
+      // the layout may not accept the dock now (e.g. a tab in a root
+      // container whose last container is not automatic): try again
+      // in the next frames
+      dcont->OpRoot_FillEmpty();
+      if (!dcont->newDockRoot(dd,cmd.iedge))
+        return DockCommand_Defer;
+    }
+    if (dd->p_open)
+      *(dd->p_open) = true;
+  }
+  return DockCommand_Done;
+}
+
+static void rejectDockCommand(const DockCommand &cmd){
+  auto it = dockht.find(string(cmd.label));
+  Dock *dd = (it != dockht.end()) ? it->second : nullptr;
+  it = dockht.find(string(cmd.target));
+  Dock *dcont = (it != dockht.end()) ? it->second : nullptr;
+  if (cmd.type == DockCommand::Type_Close)
+    pushDockEvent(DockEvent::Type_CloseRejected,dd,nullptr,cmd.label);
+  else
+    pushDockEvent(DockEvent::Type_OpenRejected,dd,dcont,cmd.label);
+}
+
+static void processDockQueue(){
+  int frame = GetFrameCount();
+  if (dockqueue_frame == frame) return;
+  dockqueue_frame = frame;
+
+  // Retry the deferred commands. Commands on a dock that has a
+  // deferred command are deferred too, to keep them in order. A
+  // command that cannot run after DockQueueMaxRetries frames is
+  // rejected.
+  int n = 0;
+  for (int i = 0; i < dockqueue_deferred.Size; i++){
+    DockCommand &cmd = dockqueue_deferred[i];
+    bool defer = false;
+    for (int j = 0; j < n && !defer; j++)
+      defer = !strcmp(dockqueue_deferred[j].label,cmd.label);
+    DockCommandResult_ res = defer ? DockCommand_Defer : runDockCommand(cmd);
+    if (res == DockCommand_Defer && ++cmd.retries > DockQueueMaxRetries)
+      res = DockCommand_Reject;
+    if (res == DockCommand_Defer)
+      dockqueue_deferred[n++] = cmd;
+    else if (res == DockCommand_Reject)
+      rejectDockCommand(cmd);
+  }
+  dockqueue_deferred.resize(n);
+
+  // run the new commands
+  DockCommand cmd;
+  while (dockqueue.pop(&cmd)){
+    bool defer = false;
+    for (int j = 0; j < dockqueue_deferred.Size && !defer; j++)
+      defer = !strcmp(dockqueue_deferred[j].label,cmd.label);
+    DockCommandResult_ res = defer ? DockCommand_Defer : runDockCommand(cmd);
+    if (res == DockCommand_Defer && dockqueue_deferred.Size >= DockQueueMaxDeferred)
+      res = DockCommand_Reject;
+    if (res == DockCommand_Defer)
+      dockqueue_deferred.push_back(cmd);
+    else if (res == DockCommand_Reject)
+      rejectDockCommand(cmd);
+  }
+}
+
+static void runDockDrawRequests(){
+  int i;
+  while ((i = dockdraw_next.fetch_add(1)) < dockdraw.Size){
+    DockDrawRequest *req = &dockdraw[i];
+    req->fn(req->drawl,&req->info,req->user_data);
+  }
+}
+
+static void dockDrawWorker(int index, unsigned int job){
+  for (;;){
+    {
+      std::unique_lock<std::mutex> lock(dockdraw_mutex);
+      dockdraw_cv_start.wait(lock,[&]{ return dockdraw_quit || dockdraw_job != job; });
+      if (dockdraw_quit || index >= dockdraw_nworkers) return;
+      job = dockdraw_job;
+    }
+    runDockDrawRequests();
+    {
+      std::lock_guard<std::mutex> lock(dockdraw_mutex);
+      if (--dockdraw_busy == 0)
+        dockdraw_cv_done.notify_one();
+    }
+  }
+}
+
+static void appendDrawList(ImDrawList *dst, ImDrawList *src){
+  if (src->VtxBuffer.Size == 0 || src->IdxBuffer.Size == 0) return;
+
+  // remove the unused last command, but keep its state
+  ImDrawCmd last = dst->CmdBuffer.back();
+  if (dst->CmdBuffer.back().ElemCount == 0 && !dst->CmdBuffer.back().UserCallback)
+    dst->CmdBuffer.pop_back();
+  last.ElemCount = 0;
+  last.UserCallback = nullptr;
+  last.UserCallbackData = nullptr;
+
+  // commands, with their vertices copied to the end of dst and their
+  // indices rebased; start a new vertex offset in dst when the
+  // indices would overflow
+  const ImDrawIdx *idx = src->IdxBuffer.Data;
+  for (int i = 0; i < src->CmdBuffer.Size; idx += src->CmdBuffer[i].ElemCount, i++){
+    ImDrawCmd cmd = src->CmdBuffer[i];
+    if (cmd.ElemCount == 0 && !cmd.UserCallback) continue;
+    unsigned int vmin = cmd.ElemCount > 0 ? idx[0] : 0, vmax = vmin;
+    for (unsigned int j = 1; j < cmd.ElemCount; j++){
+      if (idx[j] < vmin) vmin = idx[j];
+      if (idx[j] > vmax) vmax = idx[j];
+    }
+    unsigned int nvtx = cmd.ElemCount > 0 ? vmax - vmin + 1 : 0;
+    if (sizeof(ImDrawIdx) == 2 && dst->_VtxCurrentIdx + nvtx >= (1 << 16)){
+      if (!dst->_AllowVtxOffset){
+        IM_ASSERT(0 && "Too many vertices in the parallel dock drawing");
+        break;
+      }
+      dst->_VtxCurrentOffset = dst->VtxBuffer.Size;
+      dst->_VtxCurrentIdx = 0;
+    }
+
+    int vtx_size = dst->VtxBuffer.Size, idx_size = dst->IdxBuffer.Size;
+    dst->VtxBuffer.resize(vtx_size + nvtx);
+    if (nvtx > 0)
+      memcpy(dst->VtxBuffer.Data + vtx_size,src->VtxBuffer.Data + cmd.VtxOffset + vmin,nvtx * sizeof(ImDrawVert));
+    dst->IdxBuffer.resize(idx_size + cmd.ElemCount);
+    for (unsigned int j = 0; j < cmd.ElemCount; j++)
+      dst->IdxBuffer[idx_size + j] = (ImDrawIdx) (idx[j] - vmin + dst->_VtxCurrentIdx);
+    dst->_VtxCurrentIdx += nvtx;
+    cmd.VtxOffset = dst->_VtxCurrentOffset;
+    dst->CmdBuffer.push_back(cmd);
+  }
+  dst->_VtxWritePtr = dst->VtxBuffer.Data + dst->VtxBuffer.Size;
+  dst->_IdxWritePtr = dst->IdxBuffer.Data + dst->IdxBuffer.Size;
+
+  // restore the drawing state of dst
+  last.VtxOffset = dst->_VtxCurrentOffset;
+  dst->CmdBuffer.push_back(last);
+}
+
 //xx// Dock methods //xx//
 
 bool Dock::IsMouseHoveringTabBar(){
@@ -439,6 +793,7 @@ void Dock::OpStack_Remove(Dock *dd, bool erase){
 }
 
 Dock *Dock::OpRoot_ReplaceHV(Dock::Type_ type,bool before,Dock *dcont/*=nullptr*/,ImVec2 weight/*={1.f,1.f}*/){
+  ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
   // 1:top, 2:right, 3:bottom, 4:left
   Dock *dpar = this->parent;
   Dock *root = dpar->root;
@@ -456,6 +811,7 @@ Dock *Dock::OpRoot_ReplaceHV(Dock::Type_ type,bool before,Dock *dcont/*=nullptr*
     dcont->automatic = true;
     dcont->dockflags = root->dockflags;
     dcont->splitweight = weight;
+    pushDockEvent(DockEvent::Type_AutomaticCreated,dcont,dpar);
   }
   root->nchild++;
 
@@ -472,6 +828,7 @@ Dock *Dock::OpRoot_ReplaceHV(Dock::Type_ type,bool before,Dock *dcont/*=nullptr*
   dhv->automatic = true;
   dhv->dockflags = root->dockflags;
   root->nchild++;
+  pushDockEvent(DockEvent::Type_AutomaticCreated,dhv,dpar);
 
   // build the new horizontal/vertical
   if (before){
@@ -517,6 +874,7 @@ Dock *Dock::OpRoot_ReplaceHV(Dock::Type_ type,bool before,Dock *dcont/*=nullptr*
 }
 
 Dock *Dock::OpRoot_AddToHV(bool before,Dock *dcont/*=nullptr*/,ImVec2 weight/*={1.f,1.f}*/){
+  ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
   // 1:top, 2:right, 3:bottom, 4:left
   Dock *dpar = this->parent;
   Dock *root = dpar->root;
@@ -534,6 +892,7 @@ Dock *Dock::OpRoot_AddToHV(bool before,Dock *dcont/*=nullptr*/,ImVec2 weight/*={
     dcont->automatic = true;
     dcont->dockflags = root->dockflags;
     dcont->splitweight = weight;
+    pushDockEvent(DockEvent::Type_AutomaticCreated,dcont,dpar);
   }
   root->nchild++;
 
@@ -584,6 +943,7 @@ Dock *Dock::OpRoot_AddToHV(bool before,Dock *dcont/*=nullptr*/,ImVec2 weight/*={
 }
 
 void Dock::OpRoot_FillEmpty(){
+  ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
   if (!this->stack.empty() || this->type != Dock::Type_Root) return;
 
   this->nchild = 1;
@@ -601,6 +961,7 @@ void Dock::OpRoot_FillEmpty(){
   dcont->parent = this;
   dcont->root = this;
   this->stack.push_back(dcont);
+  pushDockEvent(DockEvent::Type_AutomaticCreated,dcont,this);
 }
 
 void Dock::raiseDock(){
@@ -669,7 +1030,7 @@ void Dock::focusContainer(){
       g->MovingWindow = this->window;
       g->MovingWindowMoveId = this->window->RootWindow->MoveId;
     }
-    if (this->currenttab)
+    if (this->currenttab && this->currenttab->window)
       SetActiveID(g->MovingWindowMoveId, this->currenttab->window->RootWindow);
     else
       SetActiveID(g->MovingWindowMoveId, this->window->RootWindow);
@@ -688,11 +1049,12 @@ void Dock::liftContainer(){
   this->unDock();
   this->status = Dock::Status_Dragged;
   this->hoverable = false;
+  pushDockEvent(DockEvent::Type_Lifted,this,dpar);
   this->pos = GetMousePos() - ImVec2(0.5*this->size.x,min(ImGuiStyleWidgets.TabHeight,0.2f*this->size.y));
   ClearActiveID();
   g->MovingWindow = this->window;
   g->MovingWindowMoveId = this->window->RootWindow->MoveId;
-  if (this->currenttab)
+  if (this->currenttab && this->currenttab->window)
     SetActiveID(g->MovingWindowMoveId, this->currenttab->window->RootWindow);
   else
     SetActiveID(g->MovingWindowMoveId, this->window->RootWindow);
@@ -706,6 +1068,8 @@ void Dock::newDock(Dock *dnew, int ithis /*=-1*/){
   this->currenttab = dnew;
   this->splitweight = dnew->splitweight;
   this->OpStack_Insert(dnew,ithis);
+  pushDockEvent(DockEvent::Type_Docked,dnew,this);
+  pushDockEvent(DockEvent::Type_TabActivated,dnew,this);
 }
 
 Dock *Dock::newDockRoot(Dock *dnew, Drop_ iedge){
@@ -714,11 +1078,14 @@ Dock *Dock::newDockRoot(Dock *dnew, Drop_ iedge){
   Dock *dcont = nullptr;
   if (dnew->type == Dock::Type_Container)
     dcont = dnew;
+  Dock *droot = this->root; // this may be killed if dnew replaces it
 
   if (this->type == Dock::Type_Root){
     dcont = this->stack.back()->newDockRoot(dnew,iedge);
+    if (!dcont) return nullptr;
   } else if (this->type == Dock::Type_Horizontal || this->type == Dock::Type_Vertical){
     dcont = this->stack.back()->newDockRoot(dnew,iedge);
+    if (!dcont) return nullptr;
   } else {
     if (this->parent->type == Dock::Type_Root){
       Type_ type;
@@ -756,11 +1123,15 @@ Dock *Dock::newDockRoot(Dock *dnew, Drop_ iedge){
       dcont->newDock(dnew);
   }
   dnew->status = Dock::Status_Docked;
-  dnew->root = this->root;
+  dnew->root = droot;
+  if (dnew->type == Dock::Type_Container)
+    pushDockEvent(DockEvent::Type_Docked,dnew,dnew->parent);
   return dcont;
 }
 
 void Dock::unDock(){
+  if (this->status == Dock::Status_Docked)
+    pushDockEvent(DockEvent::Type_Undocked,this,this->parent);
   this->status = Dock::Status_Open;
   this->hoverable = true;
   this->control_window_this_frame = true;
@@ -857,6 +1228,7 @@ void Dock::drawTabBar(Dock **erased/*=nullptr*/){
   text_color.w = 2.0 / g->Style.Alpha;
   bool raise = false;
   Dock *dderase = nullptr;
+  Dock *oldtab = this->currenttab;
 
   // empty the list of tabs
   this->tabsx.Size = 0;
@@ -898,6 +1270,7 @@ void Dock::drawTabBar(Dock **erased/*=nullptr*/){
         dd->unDock();
         dd->status = Dock::Status_Dragged;
         dd->hoverable = false;
+        pushDockEvent(DockEvent::Type_Lifted,dd,this);
         dd->pos = GetMousePos() - ImVec2(0.5*dd->size.x,0.f);
         goto erase_this_tab;
       }
@@ -914,6 +1287,7 @@ void Dock::drawTabBar(Dock **erased/*=nullptr*/){
       if (dd->p_open && !*(dd->p_open)){
 	dd->unDock();
 	dd->status = Dock::Status_Closed;
+        pushDockEvent(DockEvent::Type_Closed,dd,this);
         goto erase_this_tab;
       }
 
@@ -947,6 +1321,9 @@ void Dock::drawTabBar(Dock **erased/*=nullptr*/){
   PopStyleVar();
   PopStyleColor();
 
+  if (this->currenttab && this->currenttab != oldtab)
+    pushDockEvent(DockEvent::Type_TabActivated,this->currenttab,this);
+
   if (erased) 
     if (dderase)
       *erased = this;
@@ -1047,7 +1424,7 @@ void Dock::getMinSize(ImVec2 *minsize,ImVec2 *autosize){
       *minsize = g->Style.WindowMinSize;
     if (autosize)
       *autosize = g->Style.WindowMinSize + g->Style.WindowPadding;
-    if (this->currenttab){
+    if (this->currenttab && this->currenttab->window){
       if (minsize)
         minsize->y += this->tabdz;
       if (autosize){
@@ -1059,7 +1436,7 @@ void Dock::getMinSize(ImVec2 *minsize,ImVec2 *autosize){
     if (minsize)
       *minsize = g->Style.WindowMinSize;
     if (autosize)
-      *autosize = ImMax(g->Style.WindowMinSize + g->Style.WindowPadding,this->window->SizeContents);
+      *autosize = ImMax(g->Style.WindowMinSize + g->Style.WindowPadding,this->window?this->window->SizeContents:ImVec2(0.f,0.f));
   }
 }
 
@@ -1229,7 +1606,7 @@ void Dock::drawRootContainer(Dock *root, Dock **lift, Dock **erased, int *ncount
       SetNextWindowPos(this->pos);
       SetNextWindowSize(this->size);
       SetNextWindowCollapsed(this->collapsed);
-      if (this->currenttab)
+      if (this->currenttab && this->currenttab->window)
         SetNextWindowContentSize(this->currenttab->window->SizeContents + ImVec2(0.f,this->tabdz));
       if (transparentframe)
         PushStyleColor(ImGuiCol_WindowBg,TransparentColor(ImGuiCol_WindowBg));
@@ -1305,8 +1682,13 @@ void Dock::closeDock() {
 	    dpar->currenttab = dpar->stack.front();
       	else
       	  dpar->currenttab = nullptr;
+	if (dpar->currenttab)
+	  pushDockEvent(DockEvent::Type_TabActivated,dpar->currenttab,dpar);
       }
+      pushDockEvent(DockEvent::Type_Closed,this,dpar);
       dpar->killContainerMaybe();
+    } else {
+      pushDockEvent(DockEvent::Type_Closed,this);
     }
     this->status = Dock::Status_Closed;
   }
@@ -1318,10 +1700,14 @@ Dock *ImGui::RootContainer(const char* label, bool* p_open /*=nullptr*/, ImGuiWi
                        DockFlags dock_flags/*=0*/){
   bool collapsed;
   ImGuiContext *g = GetCurrentContext();
+
+  // Run the commands queued from other threads
+  processDockQueue();
   ImGuiWindowFlags flags = extra_flags;
 
   Dock *dd = dockht[string(label)];
   if (!dd){
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
     dd = new Dock;
     IM_ASSERT(dd);
     dd->label = ImStrdup(label);
@@ -1370,6 +1756,8 @@ Dock *ImGui::RootContainer(const char* label, bool* p_open /*=nullptr*/, ImGuiWi
         dd->status = Dock::Status_Open;
       }
     } else {
+      if (dd->status != Dock::Status_Closed)
+        pushDockEvent(DockEvent::Type_Closed,dd);
       dd->status = Dock::Status_Closed;
     }
   }
@@ -1407,10 +1795,14 @@ Dock *ImGui::Container(const char* label, bool* p_open /*=nullptr*/, ImGuiWindow
 
   bool collapsed = true;
   ImGuiContext *g = GetCurrentContext();
+
+  // Run the commands queued from other threads
+  processDockQueue();
   ImGuiWindowFlags flags = extra_flags;
 
   Dock *dd = dockht[string(label)];
   if (!dd){
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
     dd = new Dock;
     IM_ASSERT(dd);
     dd->label = ImStrdup(label);
@@ -1497,6 +1889,8 @@ Dock *ImGui::Container(const char* label, bool* p_open /*=nullptr*/, ImGuiWindow
           dd->hoverable = true;
         }
       } else {
+        if (dd->status != Dock::Status_Closed)
+          pushDockEvent(DockEvent::Type_Closed,dd);
         dd->status = Dock::Status_Closed;
         dd->hoverable = false;
       }
@@ -1550,9 +1944,13 @@ bool ImGui::BeginDock(const char* label, bool* p_open /*=nullptr*/, ImGuiWindowF
   bool collapsed;
   ImGuiContext *g = GetCurrentContext();
 
+  // Run the commands queued from other threads
+  processDockQueue();
+
   // Create the entry in the dock context if it doesn't exist
   Dock *dd = dockht[string(label)];
   if (!dd) {
+    ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode);
     dd = new Dock;
     IM_ASSERT(dd);
     dd->label = ImStrdup(label);
@@ -1585,10 +1983,15 @@ bool ImGui::BeginDock(const char* label, bool* p_open /*=nullptr*/, ImGuiWindowF
       flags = dd->flags | ImGuiWindowFlags_NoResize;
       collapsed = dd->hidden;
       if (dd->hidden){
+        // A tab that stays hidden gives back the memory of its draw
+        // list (it is drawn empty until it is shown again)
+        if (dd->window && ++dd->hiddenframes == g->IO.DrawListShrinkFrames)
+          dd->window->DrawList->ClearFreeMemory();
 	dd->noborder = true;
 	PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.f);
         Begin(label,nullptr,dd->size,0.0,flags);
       } else {
+        dd->hiddenframes = 0;
         Begin(label,nullptr,flags);
       }
       dd->root = dd->parent->root;
@@ -1694,6 +2097,8 @@ bool ImGui::BeginDock(const char* label, bool* p_open /*=nullptr*/, ImGuiWindowF
           dd->hoverable = true;
         }
       } else {
+        if (dd->status != Dock::Status_Closed)
+          pushDockEvent(DockEvent::Type_Closed,dd);
         dd->status= Dock::Status_Closed;
         dd->hoverable = false;
       }
@@ -1729,7 +2134,18 @@ bool ImGui::BeginDock(const char* label, bool* p_open /*=nullptr*/, ImGuiWindowF
       placeWindow(dd->window,dd->parent->window,-1);
   }
 
-  return !collapsed;
+  // Skip the contents if the dock is off-screen or occluded. Keep
+  // the contents size so the scrollbars and auto-resize of the
+  // window do not change.
+  dd->culled = !collapsed && !(dd->dockflags & Dock::DockFlags_NoCulling) && 
+    dd->status != Dock::Status_Dragged && g->ActiveIdWindow != dd->window &&
+    isWindowInvisible(dd->window);
+  if (dd->culled){
+    dd->window->DC.CursorMaxPos = dd->window->Pos + dd->window->SizeContents - dd->window->WindowPadding - dd->window->Scroll;
+    dd->window->SkipItems = true;
+  }
+
+  return !collapsed && !dd->culled;
 }
 
 Dock *ImGui::GetCurrentDock() {
@@ -1792,11 +2208,132 @@ void ImGui::PrintDock__() {
   // }
 }
 
+bool ImGui::QueueOpenDock(const char* label, const char* target, Dock::Drop_ iedge/*=Dock::Drop_Tab*/){
+  if (!target) return false;
+  return pushDockCommand(DockCommand::Type_Open,label,target,iedge);
+}
+
+bool ImGui::QueueCloseDock(const char* label){
+  return pushDockCommand(DockCommand::Type_Close,label,nullptr,Dock::Drop_None);
+}
+
+bool ImGui::PollDockEvent(DockEvent *ev){
+  if (dockevents_count == 0) return false;
+  if (ev) *ev = dockevents[dockevents_first];
+  dockevents_first = (dockevents_first + 1) % DockEventBufferSize;
+  dockevents_count--;
+  return true;
+}
+
+unsigned int ImGui::GetDockLayoutGeneration(){
+  return docklayout_generation;
+}
+
+int ImGui::GetDockEventsDropped(){
+  return dockevents_dropped;
+}
+
+bool ImGui::DockDrawParallel(DockDrawCallback fn, void* user_data, ImVec2 size/*=ImVec2(0.f,0.f)*/){
+  ImGuiContext *g = GetCurrentContext();
+  ImGuiWindow *window = GetCurrentWindow();
+  if (window->SkipItems || !fn)
+    return false;
+
+  // reserve the rectangle
+  ImVec2 avail = GetContentRegionAvail();
+  if (size.x <= 0.f) size.x = ImMax(avail.x,1.f);
+  if (size.y <= 0.f) size.y = ImMax(avail.y,1.f);
+  const ImRect bb(window->DC.CursorPos,window->DC.CursorPos + size);
+  ItemSize(bb);
+  if (!ItemAdd(bb,0))
+    return false;
+
+  // record the request with its own draw list
+  int n = dockdraw.Size;
+  if (dockdraw_lists.Size <= n)
+    dockdraw_lists.push_back(new ImDrawList);
+  ImDrawList *drawl = dockdraw_lists[n];
+  drawl->Clear();
+  drawl->_AllowVtxOffset = g->IO.RendererHasVtxOffset;
+  drawl->PushTextureID(g->Font->ContainerAtlas->TexID);
+  ImRect clip = bb;
+  clip.ClipWith(window->ClipRect);
+  drawl->PushClipRect(clip.Min,clip.Max,false);
+
+  DockDrawRequest req;
+  req.fn = fn;
+  req.user_data = user_data;
+  req.window = window;
+  req.drawl = drawl;
+  req.info.dock = currentdock;
+  req.info.rect = bb;
+  req.info.hovered = (g->HoveredWindow == window);
+  req.info.mousepos = g->IO.MousePos;
+  dockdraw.push_back(req);
+  return true;
+}
+
+void ImGui::RenderDocksParallel(int nthreads/*=0*/){
+  if (dockdraw.Size == 0) return;
+  if (nthreads <= 0)
+    nthreads = ImMax((int) std::thread::hardware_concurrency(),1);
+  nthreads = ImMin(nthreads,dockdraw.Size);
+
+  // start the workers (the calling thread is one of them); the
+  // workers beyond nthreads-1 exit instead
+  ImGuiContext *g = GetCurrentContext();
+  while ((int) dockdraw_threads.size() < nthreads-1)
+    dockdraw_threads.emplace_back(dockDrawWorker,(int) dockdraw_threads.size(),dockdraw_job);
+  {
+    std::lock_guard<std::mutex> lock(dockdraw_mutex);
+    g->DrawingInParallel = true;
+    dockdraw_next = 0;
+    dockdraw_nworkers = dockdraw_busy = nthreads-1;
+    dockdraw_job++;
+  }
+  dockdraw_cv_start.notify_all();
+  runDockDrawRequests();
+  {
+    std::unique_lock<std::mutex> lock(dockdraw_mutex);
+    dockdraw_cv_done.wait(lock,[]{ return dockdraw_busy == 0; });
+    g->DrawingInParallel = false;
+  }
+  while ((int) dockdraw_threads.size() > nthreads-1){
+    dockdraw_threads.back().join();
+    dockdraw_threads.pop_back();
+  }
+
+  // merge the draw lists into their windows, in order of submission
+  for (int i = 0; i < dockdraw.Size; i++)
+    appendDrawList(dockdraw[i].window->DrawList,dockdraw[i].drawl);
+  dockdraw.resize(0);
+}
+
 void ImGui::ShutdownDock(){
   for (auto dpair : dockht){
     if (dpair.second) delete dpair.second;
   }
   dockht.clear();
   dockwin.clear();
+  dockevents_first = dockevents_count = dockevents_dropped = 0;
+  docklayout_frame = -1;
+  DockCommand cmd;
+  while (dockqueue.pop(&cmd)) {};
+  dockqueue_deferred.clear();
+  dockqueue_frame = -1;
+
+  {
+    std::lock_guard<std::mutex> lock(dockdraw_mutex);
+    dockdraw_quit = true;
+  }
+  dockdraw_cv_start.notify_all();
+  for (auto &th : dockdraw_threads)
+    th.join();
+  dockdraw_threads.clear();
+  dockdraw_quit = false;
+  for (int i = 0; i < dockdraw_lists.Size; i++)
+    delete dockdraw_lists[i];
+  dockdraw_lists.clear();
+  dockdraw.clear();
 }
 
@@ -74,6 +74,25 @@
 // returns a pointer to the currently open dock. Otherwise, returns
 // null.
 // 
+// - ImGui::PollDockEvent: the dock layer records the changes in the
+// docking state (docked, undocked, tab activated, closed,...) in
+// an event buffer. PollDockEvent drains it one event at a time, so
+// client code can update its caches only when something changes
+// instead of checking the status of all docks every frame.
+//
+// - ImGui::QueueOpenDock and ImGui::QueueCloseDock: dock or close a
+// dock from any thread (e.g. when a job in a worker thread
+// finishes). The requests go into a lock-free queue that is drained
+// by the first RootContainer, Container or BeginDock call in each
+// frame.
+//
+// - ImGui::DockDrawParallel and ImGui::RenderDocksParallel: docks
+// with heavy drawings (plots, molecular graphics,...) can record them
+// into their own draw lists concurrently on a pool of worker
+// threads. The drawing callbacks only get a draw list and must not
+// call ImGui functions that modify the context (drawing and measuring
+// text is fine).
+//
 // - ImGui::ShutdownDock: deallocates memory for the dock hash
 // table. Should be run once docks are no longer needed, or at the end
 // of the program.
@@ -116,6 +135,7 @@ namespace ImGui{
     enum DockFlags_{
       DockFlags_NoLiftContainer = 1 << 0, // A container is not allowed to be lifted
       DockFlags_Transparent = 1 << 1,     // This window is transparent (but still handles inputs)
+      DockFlags_NoCulling = 1 << 2,       // Always submit the contents, even if the dock is not visible
     };
 
     char* label = nullptr; // dock and window label
@@ -138,9 +158,11 @@ namespace ImGui{
     int splithint = 0; // hint to tell which bar should be removed when lifted (0 = any, +1 right/up, -1 left/down)
     ImVec2 splitweight = {1.f,1.f}; // relative weight of this dock - used to set the initial position of the bar in a h-v split
     bool hidden = false; // whether a docked window is hidden
+    int hiddenframes = 0; // number of frames in a row the docked window has been hidden
     bool noborder = false; // flag if we pushed to have no border
     bool showingdrops = false; // true if we are showing the drop targets for this dock
     bool hoverable = true; // whether a window responds to being hovered
+    bool culled = false; // whether the contents were skipped this frame (off-screen or occluded)
     std::list<Dock *> stack = {}; // stack of docks at this level
     Dock *currenttab = nullptr; // currently selected tab (container)
     Dock *parent = nullptr; // immediate dock to which this is dock
@@ -153,6 +175,9 @@ namespace ImGui{
 
     Dock(){};
     ~Dock(){ MemFree(label);}
+    // Dock nodes are counted in the DockNode allocation statistics
+    static void* operator new(size_t sz){ ImGuiMemTagScope mem_tag(ImGuiMemTag_DockNode); return MemAlloc(sz);}
+    static void operator delete(void* ptr){ MemFree(ptr);}
 
     // Is the mouse hovering the tab bar of this dock? (no rectangle clipping)
     bool IsMouseHoveringTabBar();
@@ -307,6 +332,20 @@ namespace ImGui{
     void closeDock();
   }; // struct Dock
 
+  // An event in the docking system, as returned by PollDockEvent.
+  struct DockEvent{
+    enum Type_{Type_None,Type_Docked,Type_Undocked,Type_TabActivated,Type_Closed,
+               Type_Lifted,Type_AutomaticCreated,Type_AutomaticKilled,Type_LayoutChanged,
+               Type_OpenRejected,Type_CloseRejected};
+
+    Type_ type = Type_None; // type of event
+    Dock *dock = nullptr; // dock that caused the event (dangling for Type_AutomaticKilled, null for Type_OpenRejected and Type_CloseRejected if never created)
+    Dock *parent = nullptr; // container involved: destination if docked, origin if undocked or lifted
+    ImGuiID id = 0; // hash of the dock label (use instead of dock if killed)
+    int frame = 0; // frame in which the event happened
+    unsigned int generation = 0; // layout generation after the event
+  };
+
   // Create a root container with the given label. If p_open, with a
   // close button (close status as *p_open). Extra window flags are
   // passed to the container window. Dock flags can also be passed
@@ -328,9 +367,13 @@ namespace ImGui{
   // passed (see above). If a pointer to a container is passed in
   // oncedock, dock to that container in the first pass. Returns true
   // if the window is open and accepts items (same as ImGui's
-  // Begin). The EndDock() function needs to be used after all items
-  // have been added. See closeDock() note above for how to set
-  // p_open externally to close a dock.
+  // Begin). BeginDock also returns false if the dock lies outside
+  // the display or is completely covered by an opaque window above
+  // it; the window is kept alive but its contents should not be
+  // submitted (use DockFlags_NoCulling to disable this). The
+  // EndDock() function needs to be used after all items have been
+  // added. See closeDock() note above for how to set p_open
+  // externally to close a dock.
   bool BeginDock(const char* label, bool* p_open=nullptr, ImGuiWindowFlags extra_flags=0, 
                   DockFlags dock_flags=0, Dock *oncedock=nullptr);
   void EndDock();
@@ -340,6 +383,75 @@ namespace ImGui{
   // BeginDock and EndDock. Returns null if no dock is open.
   Dock *GetCurrentDock();
 
+  // Remove the oldest event from the dock event buffer and copy it
+  // to ev. Returns false if there are no events left. Docked,
+  // undocked, closed, lifted, and automatic container events bump
+  // the layout generation; a Type_LayoutChanged event is recorded
+  // the first time this happens in a frame. The buffer holds the
+  // last 256 events: if it is not drained, the oldest events are
+  // overwritten and counted as dropped.
+  bool PollDockEvent(DockEvent *ev);
+
+  // Current layout generation. Incremented every time the layout of
+  // docks and containers changes.
+  unsigned int GetDockLayoutGeneration();
+
+  // Number of events overwritten before being polled.
+  int GetDockEventsDropped();
+
+  // Request that the dock with the given label be docked to the
+  // container or root container with label target, at edge iedge
+  // (Drop_Tab: as a tab of a container, or in the empty automatic
+  // container of a root container). The dock is created if it does
+  // not exist, but it still needs to be submitted with
+  // BeginDock/EndDock. Docks that are already docked are not
+  // moved. If the target does not exist yet or its layout does not
+  // take the dock now, the request is retried in the following
+  // frames. Requests that cannot be carried out (the target is not a
+  // container, an edge of a container that is not docked, or still
+  // pending after a few seconds) are dropped and reported with a
+  // Type_OpenRejected event. Can be called from any thread. Returns
+  // false if the queue is full or the labels are too long.
+  bool QueueOpenDock(const char* label, const char* target, Dock::Drop_ iedge=Dock::Drop_Tab);
+
+  // Request that the dock with the given label be closed (see
+  // closeDock). If the dock has a p_open, it is set to false. The
+  // request waits for the pending requests on the same dock; if it
+  // cannot be carried out, it is dropped and reported with a
+  // Type_CloseRejected event. Can be called from any thread. Returns
+  // false if the queue is full or the label is too long.
+  bool QueueCloseDock(const char* label);
+
+  // Information passed to a parallel dock drawing callback.
+  struct DockDrawInfo{
+    Dock *dock = nullptr; // dock being drawn (null if not in a dock)
+    ImRect rect = {}; // rectangle reserved for the drawing (screen coordinates)
+    bool hovered = false; // whether the window was hovered (previous frame's hover state)
+    ImVec2 mousepos = {}; // mouse position
+  };
+  typedef void (*DockDrawCallback)(ImDrawList* drawl, const DockDrawInfo* info, void* user_data);
+
+  // Reserve a rectangle of the given size in the current window
+  // (zero components fill the available content region) and request
+  // that it be drawn by the callback fn in RenderDocksParallel. The
+  // callback runs in a worker thread, concurrently with the callbacks
+  // of other docks, so it can only add primitives to the draw list
+  // it receives and read (not modify) the ImGui state. Text can be
+  // drawn (AddText) and measured (CalcTextSize): while the callbacks
+  // run, the text size cache is not used and the font keeps track
+  // of the glyphs loaded on demand under a lock. The drawing is
+  // placed on top of the other contents of the window. Returns false
+  // if the rectangle is clipped and the callback will not run.
+  bool DockDrawParallel(DockDrawCallback fn, void* user_data, ImVec2 size=ImVec2(0.f,0.f));
+
+  // Run the drawing callbacks requested in this frame with
+  // DockDrawParallel on nthreads threads (0 = number of cores) and
+  // merge the resulting draw lists into their windows. The worker
+  // threads are kept between calls; if fewer are needed than in the
+  // previous call, the extra ones are stopped. Call after all windows
+  // have been submitted and before ImGui::Render().
+  void RenderDocksParallel(int nthreads=0);
+
   // Free the memory occupied dock hash tables.
   void ShutdownDock();
 
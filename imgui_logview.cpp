@@ -0,0 +1,434 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>, Robin Myhr <x@example.com>, Isaac
+  Visintainer <x@example.com>, Richard Greaves <x@example.com>, Ángel
+  Martín Pendás <angel@fluor.quimica.uniovi.es> and Víctor Luaña
+  <victor@fluor.quimica.uniovi.es>.
+
+  critic2 is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or (at
+  your option) any later version.
+
+  critic2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// See header file (imgui_logview.h) for instructions.
+
+#include "imgui_logview.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <string.h>
+#include <stdint.h>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ImGui;
+
+static const size_t nofound = (size_t) -1;
+
+bool LogViewer::OpenFile(const char* filename){
+  Clear();
+
+  size_t fsize = 0;
+#ifdef _WIN32
+  // Let the program writing the log keep it open
+  HANDLE fh = CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE,
+                          NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+  if (fh == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER li;
+  if (!GetFileSizeEx(fh,&li) || (ImU64) li.QuadPart > (ImU64) SIZE_MAX){
+    CloseHandle(fh);
+    return false;
+  }
+  fsize = (size_t) li.QuadPart;
+  if (fsize > 0){
+    HANDLE mh = CreateFileMappingA(fh,NULL,PAGE_READONLY,0,0,NULL);
+    void *ptr = mh ? MapViewOfFile(mh,FILE_MAP_READ,0,0,0) : NULL;
+    if (!ptr){
+      if (mh) CloseHandle(mh);
+      CloseHandle(fh);
+      return false;
+    }
+    hmapping = mh;
+    mapping = ptr;
+  }
+  hfile = fh;
+#else
+  int fd = open(filename,O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd,&st) != 0 || (ImU64) st.st_size > (ImU64) SIZE_MAX){
+    close(fd);
+    return false;
+  }
+  fsize = (size_t) st.st_size;
+  if (fsize > 0){
+    void *ptr = mmap(NULL,fsize,PROT_READ,MAP_PRIVATE,fd,0);
+    if (ptr == MAP_FAILED){
+      close(fd);
+      return false;
+    }
+    mapping = ptr;
+  }
+  close(fd);
+#endif
+
+  mappingsize = fsize;
+  if (fsize > 0){
+    Chunk c;
+    c.data = (char *) mapping;
+    c.size = fsize;
+    c.capacity = 0;
+    c.start = 0;
+    chunks.push_back(c);
+    size = fsize;
+  }
+  return true;
+}
+
+void LogViewer::Append(const char* text, const char* text_end/*=nullptr*/){
+  if (!text_end) text_end = text + strlen(text);
+  size_t len = (size_t) (text_end - text);
+  if (len == 0) return;
+  ImGuiMemTagScope mem_tag(ImGuiMemTag_TextBuffer);
+
+  // the unfinished last line must be known to keep it in one chunk
+  if (indexed < size)
+    BuildIndex(nofound);
+
+  Chunk *c = chunks.empty() ? nullptr : &chunks.back();
+  if (!c || c->size + len > c->capacity){
+    // Start a new chunk and move the unfinished last line to it. Its
+    // offset in the text does not change.
+    size_t partial = size - lastline;
+    size_t cap = partial + len > chunksize ? partial + len : chunksize;
+    Chunk cnew;
+    cnew.data = (char *) MemAlloc(cap);
+    cnew.capacity = cap;
+    cnew.size = partial;
+    cnew.start = lastline;
+    if (c){
+      if (partial > 0)
+        memcpy(cnew.data, c->data + (c->size - partial), partial);
+      c->size -= partial;
+      if (c->size == 0){
+        if (c->capacity > 0) MemFree(c->data);
+        chunks.pop_back();
+      }
+    }
+    chunks.push_back(cnew);
+    c = &chunks.back();
+  }
+  memcpy(c->data + c->size, text, len);
+  c->size += len;
+  size += len;
+  BuildIndex(nofound);
+}
+
+void LogViewer::Clear(){
+  for (int i = 0; i < chunks.Size; i++)
+    if (chunks[i].capacity > 0)
+      MemFree(chunks[i].data);
+  chunks.clear();
+  index.clear();
+#ifdef _WIN32
+  if (mapping) UnmapViewOfFile(mapping);
+  if (hmapping) CloseHandle((HANDLE) hmapping);
+  if (hfile) CloseHandle((HANDLE) hfile);
+  hfile = hmapping = nullptr;
+#else
+  if (mapping) munmap(mapping,mappingsize);
+#endif
+  mapping = nullptr;
+  mappingsize = 0;
+  size = indexed = lastline = 0;
+  nlines = 0;
+  scrollto = highlight = -1;
+  topline = 0;
+}
+
+bool LogViewer::BuildIndex(size_t maxbytes){
+  if (index.empty())
+    index.push_back(0);
+
+  size_t stop = size - indexed > maxbytes ? indexed + maxbytes : size;
+  while (indexed < stop){
+    const char *end;
+    const char *p = pointerTo(indexed,&end);
+    if ((size_t) (end - p) > stop - indexed)
+      end = p + (stop - indexed);
+    for (const char *q = p; (q = (const char *) memchr(q,'\n',end - q)); ){
+      q++;
+      lastline = indexed + (q - p);
+      if (++nlines % IndexStride == 0)
+        index.push_back(lastline);
+    }
+    indexed += end - p;
+  }
+  return indexed == size;
+}
+
+int LogViewer::GetLineCount() const{
+  return nlines + (lastline < indexed ? 1 : 0);
+}
+
+bool LogViewer::GetLine(int i, const char** line_begin, const char** line_end) const{
+  if (i < 0 || i >= GetLineCount()) return false;
+  lineText(lineStart(i),line_begin,line_end);
+  return true;
+}
+
+int LogViewer::GetLineAtOffset(size_t offset) const{
+  if (index.empty()) return 0;
+  if (offset > indexed) offset = indexed;
+
+  // last indexed line at or before offset
+  int lo = 0, hi = index.Size - 1;
+  while (lo < hi){
+    int mid = (lo + hi + 1) / 2;
+    if (index[mid] <= offset)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  // count the newlines from there
+  int line = lo * IndexStride;
+  size_t off = index[lo];
+  while (off < offset){
+    const char *end;
+    const char *p = pointerTo(off,&end);
+    if ((size_t) (end - p) > offset - off)
+      end = p + (offset - off);
+    for (const char *q = p; (q = (const char *) memchr(q,'\n',end - q)); q++)
+      line++;
+    off += end - p;
+  }
+  return line;
+}
+
+int LogViewer::Find(const char* needle, int from_line, bool backwards/*=false*/){
+  size_t len = strlen(needle);
+  if (len == 0) return -1;
+  BuildIndex(nofound);
+  int nl = GetLineCount();
+  if (nl == 0) return -1;
+
+  size_t off = nofound;
+  if (!backwards){
+    // from the line after from_line to the end, then from the beginning
+    size_t a = (from_line + 1 < nl && from_line >= -1) ? lineStart(from_line + 1) : 0;
+    off = search(needle,len,a,size,false);
+    if (off == nofound && a > 0)
+      off = search(needle,len,0,a,false);
+  } else {
+    // Go back one indexed block at a time, so a match close to the
+    // start line is found without scanning the text before it.
+    size_t b = (from_line > 0 && from_line < nl) ? lineStart(from_line) : size;
+    for (int k = GetLineAtOffset(b) / IndexStride; k >= 0 && off == nofound; k--){
+      size_t kend = (k + 1 < index.Size && index[k+1] < b) ? index[k+1] : b;
+      off = search(needle,len,index[k],kend,true);
+    }
+    if (off == nofound && b < size)
+      off = search(needle,len,b,size,true);
+  }
+  if (off == nofound) return -1;
+
+  highlight = GetLineAtOffset(off);
+  scrollto = highlight;
+  return highlight;
+}
+
+void LogViewer::Draw(const char* str_id, const ImVec2& size_arg/*=ImVec2(0,0)*/, LogViewerFlags flags/*=0*/){
+  // index a mapped file a few MB per frame
+  if (indexed < size)
+    BuildIndex(indexbudget);
+
+  PushID(str_id);
+  if (flags & LogViewerFlags_Toolbar){
+    PushItemWidth(GetFontSize() * 15.f);
+    bool find = InputText("##find",findbuf,IM_ARRAYSIZE(findbuf),ImGuiInputTextFlags_EnterReturnsTrue);
+    PopItemWidth();
+    SameLine();
+    bool findprev = Button("<");
+    SameLine();
+    find |= Button(">");
+    if ((find || findprev) && findbuf[0]){
+      int from = highlight >= 0 ? highlight : -1;
+      if (Find(findbuf,from,findprev) < 0)
+        highlight = -1;
+    }
+    SameLine();
+    PushItemWidth(GetFontSize() * 6.f);
+    if (InputInt("Line",&gotoline,0,0,ImGuiInputTextFlags_EnterReturnsTrue) && gotoline > 0)
+      ScrollToLine(gotoline - 1);
+    PopItemWidth();
+    SameLine();
+    if (indexed < size)
+      TextDisabled("%d lines (indexing, %d%%)",GetLineCount(),(int) (100. * (double) indexed / (double) size));
+    else
+      TextDisabled("%d lines",GetLineCount());
+  }
+
+  BeginChild(str_id,size_arg,false,ImGuiWindowFlags_HorizontalScrollbar);
+  ImGuiContext *g = GetCurrentContext();
+  ImGuiWindow *window = GetCurrentWindow();
+  const int nl = GetLineCount();
+  const float lineheight = GetTextLineHeightWithSpacing();
+  const float viewheight = GetWindowContentRegionMax().y - GetWindowContentRegionMin().y;
+  const float starty = GetCursorPosY();
+  const float scrollmax = GetScrollMaxY();
+  const bool exact = (double) nl * lineheight <= (double) MaxScrollHeight;
+  const bool follow = (flags & LogViewerFlags_AutoScroll) && GetScrollY() >= scrollmax;
+  const int maxtop = ImMax(nl - (int) (viewheight / lineheight),0);
+
+  // Line at the top of the view. A short text is scrolled by pixels.
+  // A long one has MaxScrollHeight pixels of content: dragging the
+  // scrollbar places topline in proportion, and any other change of
+  // the scroll position (wheel, keys) moves it by whole lines.
+  float scroll = GetScrollY();
+  if (exact){
+    topline = ImMax((int) ((scroll - starty) / lineheight),0);
+    if (scrollto >= 0)
+      SetScrollY((float) ImMin(scrollto,nl) * lineheight);
+  } else {
+    if (scrollto >= 0)
+      topline = scrollto;
+    else if (follow)
+      topline = maxtop;
+    else if (scroll != lastscroll && g->ActiveId == window->GetIDNoKeepAlive("#SCROLLY"))
+      topline = (int) ((double) scroll / scrollmax * maxtop + 0.5);
+    else if (scroll != lastscroll)
+      topline += (int) floorf((scroll - lastscroll) / lineheight + 0.5f);
+    topline = ImClamp(topline,0,maxtop);
+    scroll = maxtop > 0 ? (float) ((double) scrollmax * topline / maxtop) : 0.f;
+    window->Scroll.y = scroll;
+  }
+  scrollto = -1;
+  lastscroll = scroll;
+
+  char numfmt[16] = {};
+  if (flags & LogViewerFlags_LineNumbers){
+    int ndigits = 1;
+    for (int n = nl; n >= 10; n /= 10)
+      ndigits++;
+    ImFormatString(numfmt,IM_ARRAYSIZE(numfmt),"%%%dd",ndigits);
+  }
+
+  // the rows are placed relative to topline, so their positions stay
+  // within the view whatever the line number
+  const int iend = ImMin(topline + (int) (viewheight / lineheight) + 2,nl);
+  if (topline < iend){
+    SetCursorPosY(exact ? starty + topline * lineheight : starty + scroll);
+    size_t off = lineStart(topline);
+    for (int i = topline; i < iend; i++){
+      const char *b, *e;
+      off = lineText(off,&b,&e);
+      if (e - b > MaxLineDraw)
+        e = b + MaxLineDraw;
+      if (i == highlight){
+        ImVec2 pos = GetCursorScreenPos();
+        GetWindowDrawList()->AddRectFilled(ImVec2(GetWindowPos().x,pos.y),ImVec2(GetWindowPos().x + GetWindowWidth(),pos.y + GetTextLineHeight()),
+                                           GetColorU32(ImGuiCol_TextSelectedBg));
+      }
+      if (flags & LogViewerFlags_LineNumbers){
+        TextDisabled(numfmt,i+1);
+        SameLine();
+      }
+      TextUnformatted(b,e);
+    }
+  }
+
+  // the height of the content, with the last row set up as the
+  // list clipper does for SetScrollHere
+  SetCursorPosY(starty + (exact ? nl * lineheight : (float) MaxScrollHeight));
+  window->DC.CursorPosPrevLine.y = window->DC.CursorPos.y - lineheight;
+  window->DC.PrevLineHeight = lineheight - g->Style.ItemSpacing.y;
+
+  if (follow && exact)
+    SetScrollHere(1.0f);
+  EndChild();
+  PopID();
+}
+
+int LogViewer::findChunk(size_t offset) const{
+  // last chunk starting at or before offset
+  int lo = 0, hi = chunks.Size - 1;
+  while (lo < hi){
+    int mid = (lo + hi + 1) / 2;
+    if (chunks[mid].start <= offset)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+const char *LogViewer::pointerTo(size_t offset, const char **chunk_end) const{
+  const Chunk &c = chunks[findChunk(offset)];
+  *chunk_end = c.data + c.size;
+  return c.data + (offset - c.start);
+}
+
+size_t LogViewer::lineStart(int i) const{
+  size_t off = index[i / IndexStride];
+  for (int n = i % IndexStride; n > 0; n--){
+    const char *end;
+    const char *p = pointerTo(off,&end);
+    const char *q = (const char *) memchr(p,'\n',end - p);
+    IM_ASSERT(q);
+    off += (q + 1) - p;
+  }
+  return off;
+}
+
+size_t LogViewer::lineText(size_t offset, const char **line_begin, const char **line_end) const{
+  if (offset >= size){
+    *line_begin = *line_end = "";
+    return size;
+  }
+  const char *end;
+  const char *p = pointerTo(offset,&end);
+  const char *q = (const char *) memchr(p,'\n',end - p);
+  size_t next = offset + (q ? (q + 1) - p : end - p);
+  if (!q) q = end;
+  if (q > p && q[-1] == '\r') q--;
+  *line_begin = p;
+  *line_end = q;
+  return next;
+}
+
+size_t LogViewer::search(const char *needle, size_t len, size_t a, size_t b, bool last) const{
+  size_t found = nofound;
+  while (a < b){
+    const char *end;
+    const char *p = pointerTo(a,&end);
+    if ((size_t) (end - p) > b - a)
+      end = p + (b - a);
+    for (const char *q = p; end - q >= (ptrdiff_t) len; q++){
+      q = (const char *) memchr(q,needle[0],(end - q) - len + 1);
+      if (!q) break;
+      if (memcmp(q,needle,len) == 0){
+        found = a + (q - p);
+        if (!last) return found;
+      }
+    }
+    a += end - p;
+  }
+  return found;
+}
@@ -0,0 +1,261 @@
+// -*-c++-*-
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>, Robin Myhr <x@example.com>, Isaac
+  Visintainer <x@example.com>, Richard Greaves <x@example.com>, Ángel
+  Martín Pendás <angel@fluor.quimica.uniovi.es> and Víctor Luaña
+  <victor@fluor.quimica.uniovi.es>.
+
+  critic2 is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or (at
+  your option) any later version.
+
+  critic2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A viewer for very large read-only texts (program logs, outputs of
+// long calculations,...). TextUnformatted with a list clipper needs
+// the whole text in one buffer and the line starts computed again
+// every frame. Instead, the LogViewer:
+//
+// - Memory-maps a file (OpenFile), so opening it costs nothing and
+// the text is paged in by the OS as it is shown, or keeps the text
+// in chunks when it is passed in pieces (Append). A line never spans
+// two chunks, so appending never moves more than the last partial
+// line.
+//
+// - Keeps a sparse index with the offset of one in every
+// LogViewer::IndexStride lines. The index of a mapped file is built
+// a few MB at a time in Draw (indexbudget), so the line count grows
+// during the first frames after opening a large file. Finding the
+// start of a line scans at most IndexStride lines from the closest
+// indexed one. For a 1 GB log with 10 million lines the index takes
+// about 1.2 MB.
+//
+// - Draws only the visible lines. The line at the top of the view is
+// kept as an integer: a float scroll position in pixels is off by
+// whole lines past a few million lines. Up to MaxScrollHeight pixels
+// of text the view scrolls by pixels as usual. Beyond that, the
+// scrollbar gives the position in the text and the mouse wheel and
+// the keys move by lines. Jumping to a line (ScrollToLine) and
+// searching (Find) work on the index.
+//
+// Lines longer than LogViewer::MaxLineDraw bytes are cut when drawn.
+// The file is mapped once: text written to it after OpenFile is not
+// seen until the file is opened again.
+//
+// Worker threads can feed a LogViewer through a LogRing, a lock-free
+// multi-producer queue of short text records (see LockFreeQueue in
+// imgui_widgets.h). Any thread calls Push or Printf; the GUI thread
+// calls LogViewer::Drain once per frame before Draw. Each message is
+// one line. A message takes consecutive records, so the lines of
+// different threads are never mixed. When the ring is full, the
+// message is dropped and counted (LogRing::Policy_Drop, the default)
+// or the producer waits until the GUI thread makes room
+// (LogRing::Policy_Block). The viewer shows how many messages were
+// dropped where it happened.
+
+#ifndef IMGUI_LOGVIEW_H
+#define IMGUI_LOGVIEW_H
+
+#include "imgui.h"
+#include "imgui_widgets.h"
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+
+namespace ImGui{
+
+  typedef int LogViewerFlags;
+
+  // One record of a LogRing: a piece of a message.
+  struct LogRingRecord{
+    static const int Size = 118; // bytes of text per record
+    char text[Size]; // text (not null-terminated)
+    unsigned char len; // bytes used in text
+    unsigned char last; // whether this is the last record of the message
+  };
+
+  // Lock-free ring of text messages with N records (N must be a
+  // power of two). Messages longer than MaxRecords records are cut.
+  template<int N>
+  struct LogRing{
+    enum Policy_{
+      Policy_Drop,  // Drop a message if there is no room for it
+      Policy_Block, // Wait until there is room for the message
+    };
+    static const int MaxRecords = N < 32 ? N : 32; // longest message, in records
+
+    LockFreeQueue<LogRingRecord,N> queue; // the records
+    Policy_ policy = Policy_Drop; // what to do when the ring is full
+    std::atomic<size_t> dropped{0}; // number of messages dropped
+    std::atomic<size_t> stalled{0}; // number of messages that waited for room
+
+    // Push a message (one line, a trailing newline is removed). Any
+    // thread. Returns false if it was dropped.
+    bool Push(const char* text, const char* text_end = nullptr){
+      if (!text_end) text_end = text + strlen(text);
+      if (text_end > text && text_end[-1] == '\n') text_end--;
+      LogRingRecord recs[MaxRecords];
+      int n = 0;
+      do {
+        size_t len = (size_t) (text_end - text);
+        recs[n].len = (unsigned char) (len < LogRingRecord::Size ? len : LogRingRecord::Size);
+        memcpy(recs[n].text,text,recs[n].len);
+        recs[n].last = 0;
+        text += recs[n].len;
+        n++;
+      } while (text < text_end && n < MaxRecords);
+      recs[n-1].last = 1;
+
+      if (queue.push(recs,n))
+        return true;
+      if (policy == Policy_Drop){
+        dropped.fetch_add(1,std::memory_order_relaxed);
+        return false;
+      }
+      stalled.fetch_add(1,std::memory_order_relaxed);
+      while (!queue.push(recs,n))
+        std::this_thread::yield();
+      return true;
+    }
+
+    // Push a formatted message. Any thread.
+    bool Printf(const char* fmt, ...) IM_FMTARGS(2){
+      char buf[MaxRecords * LogRingRecord::Size + 1];
+      va_list args;
+      va_start(args, fmt);
+      int len = ImFormatStringV(buf,IM_ARRAYSIZE(buf),fmt,args);
+      va_end(args);
+      return Push(buf,buf+len);
+    }
+  };
+
+  struct LogViewer{
+    enum LogViewerFlags_{
+      LogViewerFlags_LineNumbers = 1 << 0, // Show the line numbers on the left
+      LogViewerFlags_Toolbar = 1 << 1,     // Show a search box and a go-to-line box above the text
+      LogViewerFlags_AutoScroll = 1 << 2,  // Follow the end of the text when new text is appended, if the view is at the bottom
+    };
+    static const int IndexStride = 64; // lines between two entries of the index
+    static const int MaxLineDraw = 4096; // longest line drawn, in bytes
+    static const int MaxScrollHeight = 1 << 20; // tallest text scrolled by pixels
+
+    // A piece of text. Lines never cross the end of a chunk.
+    struct Chunk{
+      char *data; // text
+      size_t size; // bytes used
+      size_t capacity; // bytes allocated (0 if not owned: the file mapping)
+      size_t start; // offset of the first byte in the whole text
+    };
+
+    ImVector<Chunk> chunks = {}; // the text
+    size_t size = 0; // total size of the text
+    size_t chunksize = 1 << 20; // minimum size of the chunks allocated by Append
+    size_t indexbudget = 32 << 20; // bytes of a mapped file indexed per frame
+    ImVector<ImU64> index = {}; // index[k] = offset of the start of line k * IndexStride
+    size_t indexed = 0; // the text has been indexed up to this offset
+    size_t lastline = 0; // offset of the start of the last line (the first one not ended by a newline)
+    int nlines = 0; // number of newlines in the indexed text
+    int scrollto = -1; // line requested by ScrollToLine
+    int topline = 0; // line at the top of the view
+    float lastscroll = 0.f; // scroll position left by the last Draw
+    int highlight = -1; // line highlighted by the last Find
+    char findbuf[128] = {}; // contents of the toolbar search box
+    int gotoline = 0; // contents of the toolbar go-to-line box
+    ImVector<char> drainbuf = {}; // text drained from a LogRing in this frame
+    size_t draindropped = 0; // dropped messages already reported
+    bool draininline = false; // the last record drained was not the end of its message
+    void *mapping = nullptr; // mapped file
+    size_t mappingsize = 0; // size of the mapped file
+#ifdef _WIN32
+    void *hfile = nullptr, *hmapping = nullptr; // file and file mapping handles
+#endif
+
+    LogViewer(){};
+    ~LogViewer(){ Clear();}
+
+    // Show the contents of a file. The file is memory-mapped and its
+    // index built during the next frames. Returns false if the file
+    // could not be opened, leaving the viewer empty.
+    bool OpenFile(const char* filename);
+    // Append text at the end. The new lines are indexed right away.
+    void Append(const char* text, const char* text_end = nullptr);
+    // Remove all the text and unmap the file.
+    void Clear();
+    // Index up to maxbytes of text not indexed yet. Returns true if
+    // all the text is indexed. Called by Draw.
+    bool BuildIndex(size_t maxbytes);
+    // Number of lines (of the indexed part of the text)
+    int GetLineCount() const;
+    // Text of line i, without the newline. Returns false if the
+    // line does not exist.
+    bool GetLine(int i, const char** line_begin, const char** line_end) const;
+    // Line containing the byte at offset.
+    int GetLineAtOffset(size_t offset) const;
+    // Scroll the view so that line i is shown at the top in the next Draw.
+    void ScrollToLine(int i){ scrollto = i;}
+    // Find the first line after from_line (or the last one before it,
+    // if backwards) that contains needle, and highlight and scroll to
+    // it. The search wraps around the end of the text. Returns the
+    // line or -1 if not found. The whole text is indexed first.
+    int Find(const char* needle, int from_line, bool backwards = false);
+    // Draw the viewer in a child window of the given size (see
+    // BeginChild for the meaning of size).
+    void Draw(const char* str_id, const ImVec2& size = ImVec2(0,0), LogViewerFlags flags = 0);
+    // Append the messages waiting in a ring, up to maxrecords
+    // records. Call from the GUI thread, once per frame. Returns the
+    // number of records drained.
+    template<int N>
+    int Drain(LogRing<N>& ring, int maxrecords = N){
+      drainbuf.resize(0);
+      size_t ndropped = ring.dropped.load(std::memory_order_relaxed);
+      if (ndropped != draindropped && !draininline){
+        char tmp[64];
+        int len = ImFormatString(tmp,IM_ARRAYSIZE(tmp),"[%lu messages dropped]\n",(unsigned long) (ndropped - draindropped));
+        drainbuf.resize(len);
+        memcpy(drainbuf.Data,tmp,len);
+        draindropped = ndropped;
+      }
+      LogRingRecord rec;
+      int n = 0;
+      while (n < maxrecords && ring.queue.pop(&rec)){
+        int pos = drainbuf.Size;
+        drainbuf.resize(pos + rec.len + (rec.last ? 1 : 0));
+        memcpy(drainbuf.Data + pos,rec.text,rec.len);
+        if (rec.last)
+          drainbuf.Data[pos + rec.len] = '\n';
+        draininline = !rec.last;
+        n++;
+      }
+      if (drainbuf.Size > 0)
+        Append(drainbuf.begin(),drainbuf.end());
+      return n;
+    }
+
+    // Internal: chunk containing the byte at offset.
+    int findChunk(size_t offset) const;
+    // Internal: pointer to the byte at offset, and end of its chunk.
+    const char *pointerTo(size_t offset, const char **chunk_end) const;
+    // Internal: offset of the start of line i (i < GetLineCount()).
+    size_t lineStart(int i) const;
+    // Internal: text of the line starting at offset, without the
+    // newline. Returns the offset of the next line.
+    size_t lineText(size_t offset, const char **line_begin, const char **line_end) const;
+    // Internal: offset of the first (or last) occurrence of needle
+    // in the text between offsets a and b, or (size_t)-1.
+    size_t search(const char *needle, size_t len, size_t a, size_t b, bool last) const;
+  }; // struct LogViewer
+
+} // namespace ImGui
+
+#endif
@@ -0,0 +1,389 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>, Robin Myhr <x@example.com>, Isaac
+  Visintainer <x@example.com>, Richard Greaves <x@example.com>, Ángel
+  Martín Pendás <angel@fluor.quimica.uniovi.es> and Víctor Luaña
+  <victor@fluor.quimica.uniovi.es>.
+
+  critic2 is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or (at
+  your option) any later version.
+
+  critic2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// See header file (imgui_table.h) for instructions.
+
+#include "imgui_table.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <string.h>
+#include <stdint.h>
+#include <algorithm>
+
+using namespace ImGui;
+
+static const int fitrows = 100; // rows measured to set the initial column widths
+
+void Table::AddColumn(const char* label, TableColumnFlags flags/*=0*/, float width/*=-1.f*/){
+  Column c;
+  ImStrncpy(c.label,label,IM_ARRAYSIZE(c.label));
+  c.width = width;
+  c.flags = flags;
+  columns.push_back(c);
+}
+
+void Table::SetData(TableGetter getter_, TableKey key_, void* user_data_, int nrows_){
+  getter = getter_;
+  key = key_;
+  user_data = user_data_;
+  nrows = nrows_;
+  selected = -1;
+  order.resize(nrows);
+  passes.resize(nrows);
+  for (int i = 0; i < nrows; i++){
+    order[i] = i;
+    passes[i] = test(i);
+  }
+  sortRows(order);
+  collectRows();
+}
+
+void Table::SetRowCount(int n){
+  if (n == nrows) return;
+  if (n < nrows){
+    int k = 0;
+    for (int i = 0; i < order.Size; i++)
+      if (order[i] < n)
+        order[k++] = order[i];
+    order.resize(k);
+    passes.resize(n);
+    if (selected >= n) selected = -1;
+  } else {
+    ImVector<int> list;
+    list.resize(n - nrows);
+    passes.resize(n);
+    for (int i = nrows; i < n; i++){
+      list[i-nrows] = i;
+      passes[i] = test(i);
+    }
+    sortRows(list);
+    mergeRows(list);
+  }
+  nrows = n;
+  collectRows();
+}
+
+void Table::UpdateRows(int first, int count){
+  if (first < 0) { count += first; first = 0;}
+  if (first + count > nrows) count = nrows - first;
+  if (count <= 0) return;
+  const int last = first + count;
+  for (int i = first; i < last; i++)
+    passes[i] = test(i);
+
+  // in data order the rows do not move
+  if (sortcolumn >= 0){
+    int k = 0;
+    for (int i = 0; i < order.Size; i++)
+      if (order[i] < first || order[i] >= last)
+        order[k++] = order[i];
+    order.resize(k);
+    ImVector<int> list;
+    list.resize(count);
+    for (int i = 0; i < count; i++)
+      list[i] = first + i;
+    sortRows(list);
+    mergeRows(list);
+  }
+  collectRows();
+}
+
+void Table::SortBy(int column, bool descending/*=false*/){
+  if (column >= columns.Size) column = -1;
+  if (column == sortcolumn){
+    // same column: reversing is enough
+    if (descending != sortdescending){
+      std::reverse(order.begin(),order.end());
+      std::reverse(rows.begin(),rows.end());
+      sortdescending = descending;
+    }
+    return;
+  }
+  sortcolumn = column;
+  sortdescending = descending;
+  sortRows(order);
+  collectRows();
+}
+
+void Table::SetFilter(const char* text){
+  if (!strcmp(text,filter)) return;
+
+  // a filter containing the previous one only removes rows
+  bool narrower = filter[0] && ImStristr(text,NULL,filter,NULL);
+  ImStrncpy(filter,text,IM_ARRAYSIZE(filter));
+  if (narrower){
+    for (int i = 0; i < rows.Size; i++)
+      passes[rows[i]] = test(rows[i]);
+  } else {
+    for (int i = 0; i < nrows; i++)
+      passes[i] = test(i);
+  }
+  collectRows();
+}
+
+bool Table::Draw(const char* str_id, const ImVec2& size_arg/*=ImVec2(0,0)*/, TableFlags flags/*=0*/){
+  ImGuiContext *g = GetCurrentContext();
+  const ImGuiStyle &style = GetStyle();
+  bool changed = false;
+
+  PushID(str_id);
+  if (flags & TableFlags_Filter){
+    PushItemWidth(GetFontSize() * 15.f);
+    if (InputText("##filter",filterbuf,IM_ARRAYSIZE(filterbuf)))
+      SetFilter(filterbuf);
+    PopItemWidth();
+    SameLine();
+    TextDisabled("%d of %d rows",rows.Size,nrows);
+  }
+
+  // column widths, measured once
+  const float pad = style.FramePadding.x;
+  colx.resize(columns.Size + 1);
+  colx[0] = 0.f;
+  for (int c = 0; c < columns.Size; c++){
+    if (columns[c].width < 0.f)
+      columns[c].width = fitWidth(c,0,ImMin(rows.Size,fitrows));
+    colx[c+1] = colx[c] + columns[c].width;
+  }
+  const float totalwidth = colx[columns.Size];
+
+  // leave room for the header, drawn after the body
+  const ImVec2 hpos = GetCursorScreenPos();
+  const float hheight = GetFontSize() + 2.f * style.FramePadding.y;
+  Dummy(ImVec2(0.f,hheight));
+  SetCursorScreenPos(ImVec2(hpos.x,hpos.y + hheight));
+
+  // body
+  BeginChild(str_id,size_arg,false,ImGuiWindowFlags_HorizontalScrollbar);
+  ImGuiWindow *window = GetCurrentWindow();
+  const float lineheight = GetTextLineHeightWithSpacing();
+  if (scrollto >= 0){
+    for (int i = 0; i < rows.Size; i++){
+      if (rows[i] == scrollto){
+        SetScrollY((float) i * lineheight);
+        break;
+      }
+    }
+    scrollto = -1;
+  }
+
+  // columns in view
+  const float x0 = window->DC.CursorPos.x;
+  const ImRect clip = window->ClipRect;
+  int c0 = 0, c1 = columns.Size;
+  while (c0 < c1 && x0 + colx[c0+1] <= clip.Min.x)
+    c0++;
+  while (c1 > c0 && x0 + colx[c1-1] >= clip.Max.x)
+    c1--;
+
+  ImDrawList *dl = window->DrawList;
+  const ImU32 textcol = GetColorU32(ImGuiCol_Text);
+  char buf[MaxCellText];
+  int vis0 = rows.Size, vis1 = 0; // rows in view
+  ImGuiListClipper clipper(rows.Size,lineheight);
+  while (clipper.Step()){
+    vis0 = ImMin(vis0,clipper.DisplayStart);
+    vis1 = ImMax(vis1,clipper.DisplayEnd);
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++){
+      const int row = rows[i];
+      const ImVec2 pos = window->DC.CursorPos;
+      const ImRect rr(pos,ImVec2(pos.x + ImMax(totalwidth,clip.Max.x - pos.x),pos.y + lineheight));
+
+      // the row is the item; the cells are only text
+      const ImGuiID id = window->GetID((void *) (intptr_t) row);
+      ItemSize(ImVec2(totalwidth,GetFontSize()));
+      bool hovered = false, held = false;
+      if (ItemAdd(rr,id) && ButtonBehavior(rr,id,&hovered,&held) && selected != row){
+        selected = row;
+        changed = true;
+      }
+      if (row == selected)
+        dl->AddRectFilled(rr.Min,rr.Max,GetColorU32(held ? ImGuiCol_HeaderActive : ImGuiCol_Header));
+      else if (hovered)
+        dl->AddRectFilled(rr.Min,rr.Max,GetColorU32(ImGuiCol_HeaderHovered));
+      else if ((flags & TableFlags_RowBg) && (i & 1))
+        dl->AddRectFilled(rr.Min,rr.Max,GetColorU32(ImGuiCol_FrameBg,0.5f));
+
+      for (int c = c0; c < c1; c++){
+        const char *text = getter(user_data,row,c,buf,IM_ARRAYSIZE(buf));
+        if (!text || !text[0]) continue;
+        const float xa = pos.x + colx[c] + pad, xb = pos.x + colx[c+1] - pad;
+        float x = xa;
+        if (columns[c].flags & TableColumnFlags_Numeric){
+          float w = CalcTextSize(text).x;
+          if (xb - w > xa) x = xb - w;
+        }
+        const ImVec4 cr(ImMax(xa,clip.Min.x),ImMax(pos.y,clip.Min.y),ImMin(xb,clip.Max.x),ImMin(pos.y + lineheight,clip.Max.y));
+        dl->AddText(g->Font,g->FontSize,ImVec2(x,pos.y),textcol,text,NULL,0.f,&cr);
+      }
+    }
+  }
+  EndChild();
+
+  // header, scrolled with the body
+  const ImRect hclip(ImVec2(clip.Min.x,hpos.y),ImVec2(clip.Max.x,hpos.y + hheight));
+  PushClipRect(hclip.Min,hclip.Max,true);
+  for (int c = c0; c < c1; c++){
+    PushID(c);
+    const ImRect cr(ImVec2(x0 + colx[c],hpos.y),ImVec2(x0 + colx[c+1],hpos.y + hheight));
+
+    // the resize grip goes first, so it takes the mouse from the headers
+    const ImRect gr(ImVec2(cr.Max.x - 4.f,cr.Min.y),ImVec2(cr.Max.x + 4.f,cr.Max.y));
+    const ImGuiID gid = GetID("##resize");
+    bool hovered = false, held = false;
+    if (ItemAdd(gr,gid)){
+      ButtonBehavior(gr,gid,&hovered,&held);
+      if (hovered || held)
+        SetMouseCursor(ImGuiMouseCursor_ResizeEW);
+      if (hovered && IsMouseDoubleClicked(0)){
+        columns[c].width = fitWidth(c,vis0,vis1);
+      } else if (held) {
+        columns[c].width = ImMax(GetIO().MousePos.x - cr.Min.x,GetFontSize());
+      }
+    }
+
+    const ImGuiID hid = GetID("##header");
+    if (ItemAdd(cr,hid)){
+      if (ButtonBehavior(cr,hid,&hovered,&held) && !(columns[c].flags & TableColumnFlags_NoSort))
+        SortBy(c,c == sortcolumn ? !sortdescending : false);
+      RenderFrame(cr.Min,cr.Max,GetColorU32(held ? ImGuiCol_HeaderActive : hovered ? ImGuiCol_HeaderHovered : ImGuiCol_Header),false);
+      float xb = cr.Max.x - pad;
+      if (c == sortcolumn){
+        xb -= GetFontSize();
+        RenderTriangle(ImVec2(xb,cr.Min.y + style.FramePadding.y),sortdescending ? ImGuiDir_Down : ImGuiDir_Up,0.7f);
+      }
+      RenderTextClipped(ImVec2(cr.Min.x + pad,cr.Min.y),ImVec2(xb,cr.Max.y),columns[c].label,NULL,NULL,ImVec2(0.f,0.5f));
+    }
+    PopID();
+  }
+  PopClipRect();
+  PopID();
+  return changed;
+}
+
+bool Table::before(int a, int b) const{
+  if (sortdescending)
+    ImSwap(a,b);
+  if (sortcolumn >= 0){
+    if (key){
+      double ka = key(user_data,a,sortcolumn), kb = key(user_data,b,sortcolumn);
+      if (ka != kb) return ka < kb;
+    } else {
+      char bufa[MaxCellText], bufb[MaxCellText];
+      const char *ta = getter(user_data,a,sortcolumn,bufa,IM_ARRAYSIZE(bufa));
+      if (ta && ta != bufa){
+        ImStrncpy(bufa,ta,IM_ARRAYSIZE(bufa));
+        ta = bufa;
+      }
+      const char *tb = getter(user_data,b,sortcolumn,bufb,IM_ARRAYSIZE(bufb));
+      int cmp = strcmp(ta ? ta : "",tb ? tb : "");
+      if (cmp != 0) return cmp < 0;
+    }
+  }
+  return a < b;
+}
+
+bool Table::test(int row) const{
+  if (!filter[0]) return true;
+  char buf[MaxCellText];
+  for (int c = 0; c < columns.Size; c++){
+    if (columns[c].flags & TableColumnFlags_NoFilter) continue;
+    const char *text = getter(user_data,row,c,buf,IM_ARRAYSIZE(buf));
+    if (text && ImStristr(text,NULL,filter,NULL))
+      return true;
+  }
+  return false;
+}
+
+void Table::sortRows(ImVector<int>& list) const{
+  if (sortcolumn < 0 || !key){
+    std::sort(list.begin(),list.end(),[this](int a, int b){ return before(a,b);});
+    return;
+  }
+
+  // get the keys once instead of twice per comparison
+  struct Entry{ double k; int row;};
+  ImVector<Entry> e;
+  e.resize(list.Size);
+  for (int i = 0; i < list.Size; i++){
+    e[i].k = key(user_data,list[i],sortcolumn);
+    e[i].row = list[i];
+  }
+  if (sortdescending)
+    std::sort(e.begin(),e.end(),[](const Entry& a, const Entry& b){ return a.k > b.k || (a.k == b.k && a.row > b.row);});
+  else
+    std::sort(e.begin(),e.end(),[](const Entry& a, const Entry& b){ return a.k < b.k || (a.k == b.k && a.row < b.row);});
+  for (int i = 0; i < list.Size; i++)
+    list[i] = e[i].row;
+}
+
+void Table::mergeRows(const ImVector<int>& list){
+  // Find where each new row goes with a binary search, then open
+  // the gaps from the end: list.Size * log(order.Size) comparisons
+  // and one pass over order.
+  const int n = order.Size, k = list.Size;
+  ImVector<int> pos;
+  pos.resize(k);
+  int lo = 0;
+  for (int j = 0; j < k; j++){
+    int hi = n;
+    while (lo < hi){
+      int mid = lo + (hi - lo) / 2;
+      if (before(list[j],order[mid]))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    pos[j] = lo;
+  }
+
+  order.resize(n + k);
+  int src = n, dst = n + k;
+  for (int j = k - 1; j >= 0; j--){
+    int cnt = src - pos[j];
+    src -= cnt;
+    dst -= cnt;
+    if (cnt > 0)
+      memmove(order.Data + dst,order.Data + src,cnt * sizeof(int));
+    order[--dst] = list[j];
+  }
+}
+
+void Table::collectRows(){
+  int k = 0;
+  rows.resize(order.Size);
+  for (int i = 0; i < order.Size; i++)
+    if (passes[order[i]])
+      rows[k++] = order[i];
+  rows.resize(k);
+  if (selected >= 0 && !passes[selected])
+    selected = -1;
+}
+
+float Table::fitWidth(int c, int first, int last) const{
+  float w = CalcTextSize(columns[c].label).x + GetFontSize();
+  char buf[MaxCellText];
+  for (int i = first; i < last && i < rows.Size; i++){
+    const char *text = getter(user_data,rows[i],c,buf,IM_ARRAYSIZE(buf));
+    if (text)
+      w = ImMax(w,CalcTextSize(text).x);
+  }
+  return w + 2.f * GetStyle().FramePadding.x;
+}
@@ -0,0 +1,152 @@
+// -*-c++-*-
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>, Robin Myhr <x@example.com>, Isaac
+  Visintainer <x@example.com>, Richard Greaves <x@example.com>, Ángel
+  Martín Pendás <angel@fluor.quimica.uniovi.es> and Víctor Luaña
+  <victor@fluor.quimica.uniovi.es>.
+
+  critic2 is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or (at
+  your option) any later version.
+
+  critic2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A table for very long lists (atoms, properties,...) with sortable
+// and filterable columns. The data stays with the caller and is read
+// through a getter that writes the text of one cell:
+//
+//   const char *getter(void *user_data, int row, int column, char *buf, int buf_size);
+//
+// It returns buf or a string owned by the caller.
+// An optional key function returns a number for one cell, used to
+// sort the table. Without it, the cells are sorted by their text,
+// which is much slower for long tables. Then:
+//
+//   Table t;
+//   t.AddColumn("Atom");
+//   t.AddColumn("x (bohr)",Table::TableColumnFlags_Numeric);
+//   t.SetData(getter,key,data,natoms);
+//   ...
+//   t.Draw("##atoms");
+//
+// Only the rows and the columns in view are drawn, and the text of a
+// cell is neither measured nor submitted as an item: the cells are
+// written directly in the window's draw list. Column widths are
+// stored in the table, measured once from the header and the first
+// rows, and can be changed by dragging the right border of a header
+// (double-click to fit the rows in view). Clicking a header sorts by
+// that column and clicking again reverses the order.
+//
+// The table keeps the permutation of all rows in sort order (order),
+// whether each row passes the filter (passes) and the rows shown
+// (rows, the rows of order that pass). They are updated
+// incrementally: rows appended with SetRowCount or changed with
+// UpdateRows are sorted among themselves and merged into order, and
+// only those rows are filtered again. A filter string that contains
+// the previous one only tests the rows that passed. Reversing the
+// order does not sort again. For 10^6 rows, order, passes and rows
+// take about 9 MB.
+
+#ifndef IMGUI_TABLE_H
+#define IMGUI_TABLE_H
+
+#include "imgui.h"
+
+namespace ImGui{
+
+  typedef int TableFlags;
+  typedef int TableColumnFlags;
+  typedef const char *(*TableGetter)(void *user_data, int row, int column, char *buf, int buf_size);
+  typedef double (*TableKey)(void *user_data, int row, int column);
+
+  struct Table{
+    enum TableFlags_{
+      TableFlags_Filter = 1 << 0, // Show a filter box above the table
+      TableFlags_RowBg = 1 << 1,  // Alternate the background of the rows
+    };
+    enum TableColumnFlags_{
+      TableColumnFlags_Numeric = 1 << 0,  // Align the text to the right
+      TableColumnFlags_NoSort = 1 << 1,   // Clicking the header does not sort
+      TableColumnFlags_NoFilter = 1 << 2, // The filter does not look at this column
+    };
+    static const int MaxCellText = 256; // longest text of a cell, in bytes
+
+    struct Column{
+      char label[64]; // header
+      float width; // width in pixels (< 0: measure in the next Draw)
+      TableColumnFlags flags; // column flags
+    };
+
+    ImVector<Column> columns = {}; // the columns
+    TableGetter getter = nullptr; // text of a cell
+    TableKey key = nullptr; // sort key of a cell (optional)
+    void *user_data = nullptr; // passed to getter and key
+    int nrows = 0; // number of rows in the data
+    ImVector<int> order = {}; // all rows, in sort order
+    ImVector<unsigned char> passes = {}; // passes[row] = row passes the filter
+    ImVector<int> rows = {}; // rows shown, in sort order
+    int sortcolumn = -1; // column the rows are sorted by (-1 = data order)
+    bool sortdescending = false; // sort in descending order
+    char filter[128] = {}; // current filter (case-insensitive substring of any cell)
+    char filterbuf[128] = {}; // contents of the filter box
+    int selected = -1; // selected row (in the data), or -1
+    int scrollto = -1; // row requested by ScrollToRow (in the data)
+    ImVector<float> colx = {}; // colx[c] = start of column c (colx[ncol] = total width)
+
+    Table(){};
+
+    // Add a column. A width < 0 is measured in the first Draw.
+    void AddColumn(const char* label, TableColumnFlags flags = 0, float width = -1.f);
+    // Set the data, with nrows rows. The rows are sorted and
+    // filtered again.
+    void SetData(TableGetter getter, TableKey key, void* user_data, int nrows);
+    // Change the number of rows. Rows appended at the end are merged
+    // into the order; rows removed from the end are dropped.
+    void SetRowCount(int n);
+    // The count rows starting at first have changed: sort and filter
+    // them again.
+    void UpdateRows(int first, int count);
+    // Sort by a column (-1 = data order).
+    void SortBy(int column, bool descending = false);
+    // Show only the rows with a cell containing text
+    // (case-insensitive). An empty text shows all rows.
+    void SetFilter(const char* text);
+    // Number of rows shown.
+    int GetRowCount() const{ return rows.Size;}
+    // Row of the data shown at position i.
+    int GetRow(int i) const{ return rows[i];}
+    // Scroll the view so that a row of the data is shown in the next
+    // Draw (if it passes the filter).
+    void ScrollToRow(int row){ scrollto = row;}
+    // Draw the table in a child window of the given size (see
+    // BeginChild for the meaning of size). Returns true if the
+    // selected row changed.
+    bool Draw(const char* str_id, const ImVec2& size = ImVec2(0,0), TableFlags flags = 0);
+
+    // Internal: whether row a goes before row b in the sort order.
+    bool before(int a, int b) const;
+    // Internal: whether a row passes the filter.
+    bool test(int row) const;
+    // Internal: sort a list of rows.
+    void sortRows(ImVector<int>& list) const;
+    // Internal: merge a sorted list of rows into order.
+    void mergeRows(const ImVector<int>& list);
+    // Internal: rebuild rows from order and passes.
+    void collectRows();
+    // Internal: measure the width of column c from its header and
+    // the rows first to last-1 shown.
+    float fitWidth(int c, int first, int last) const;
+  }; // struct Table
+
+} // namespace ImGui
+
+#endif
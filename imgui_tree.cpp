@@ -0,0 +1,193 @@
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>, Robin Myhr <x@example.com>, Isaac
+  Visintainer <x@example.com>, Richard Greaves <x@example.com>, Ángel
+  Martín Pendás <angel@fluor.quimica.uniovi.es> and Víctor Luaña
+  <victor@fluor.quimica.uniovi.es>.
+
+  critic2 is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or (at
+  your option) any later version.
+
+  critic2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// See header file (imgui_tree.h) for instructions.
+
+#include "imgui_tree.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <string.h>
+#include <stdint.h>
+
+using namespace ImGui;
+
+void Tree::SetData(TreeChildCount childcount_, TreeChild child_, TreeLabel label_, void* user_data_, int nnodes_){
+  childcount = childcount_;
+  child = child_;
+  label = label_;
+  user_data = user_data_;
+  selected = -1;
+  openbits.resize(0);
+  Rebuild(nnodes_);
+}
+
+void Tree::Rebuild(int nnodes_){
+  int nwords = (nnodes_ + 31) / 32;
+  if (nwords > openbits.Size){
+    int n0 = openbits.Size;
+    openbits.resize(nwords);
+    memset(openbits.Data + n0,0,(nwords - n0) * sizeof(ImU32));
+  }
+  openbits.resize(nwords);
+  // the new nodes in the old last word start closed too
+  if (nnodes_ > nnodes && (nnodes & 31))
+    openbits[nnodes >> 5] &= ((ImU32) 1 << (nnodes & 31)) - 1;
+  nnodes = nnodes_;
+  if (selected >= nnodes) selected = -1;
+  setrows();
+}
+
+void Tree::SetOpen(int node, bool open){
+  if (node < 0 || node >= nnodes || IsOpen(node) == open) return;
+  int i = find(node);
+  if (i >= 0)
+    toggle(i);
+  else if (open)
+    openbits[node >> 5] |= (ImU32) 1 << (node & 31);
+  else
+    openbits[node >> 5] &= ~((ImU32) 1 << (node & 31));
+}
+
+void Tree::SetAllOpen(bool open){
+  memset(openbits.Data,open ? 0xff : 0,openbits.Size * sizeof(ImU32));
+  // keep the bits past the last node clear
+  if (open && (nnodes & 31))
+    openbits.back() &= ((ImU32) 1 << (nnodes & 31)) - 1;
+  setrows();
+}
+
+bool Tree::Draw(const char* str_id, const ImVec2& size_arg/*=ImVec2(0,0)*/){
+  ImGuiContext *g = GetCurrentContext();
+  bool changed = false;
+
+  BeginChild(str_id,size_arg,false,ImGuiWindowFlags_HorizontalScrollbar);
+  ImGuiWindow *window = GetCurrentWindow();
+  const float lineheight = GetTextLineHeightWithSpacing();
+  const float indent = GetStyle().IndentSpacing;
+  if (scrollto >= 0){
+    int i = find(scrollto);
+    if (i >= 0)
+      SetScrollY((float) i * lineheight);
+    scrollto = -1;
+  }
+
+  ImDrawList *dl = window->DrawList;
+  const ImRect clip = window->ClipRect;
+  const ImU32 textcol = GetColorU32(ImGuiCol_Text);
+  char buf[MaxLabel];
+  int toggled = -1;
+  ImGuiListClipper clipper(visible.Size,lineheight);
+  while (clipper.Step()){
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++){
+      const Row &r = visible[i];
+      const ImVec2 pos = window->DC.CursorPos;
+      const float x = pos.x + r.depth * indent;
+      const char *text = label(user_data,r.node,buf,IM_ARRAYSIZE(buf));
+      if (!text) text = "";
+      const float width = (x - pos.x) + g->FontSize * 1.5f + CalcTextSize(text).x;
+      const ImRect rr(pos,ImVec2(ImMax(pos.x + width,clip.Max.x),pos.y + lineheight));
+
+      // the row is the item; opening and closing are handled after
+      // the loop, since they change the visible rows
+      const ImGuiID id = window->GetID((void *) (intptr_t) r.node);
+      ItemSize(ImVec2(width,g->FontSize));
+      bool hovered = false, held = false;
+      bool pressed = ItemAdd(rr,id) && ButtonBehavior(rr,id,&hovered,&held);
+      const bool leaf = childcount(user_data,r.node) == 0;
+      if (!leaf && ((pressed && g->IO.MousePos.x < x + g->FontSize) || (hovered && IsMouseDoubleClicked(0))))
+        toggled = i;
+      else if (pressed && selected != r.node){
+        selected = r.node;
+        changed = true;
+      }
+
+      if (r.node == selected)
+        dl->AddRectFilled(rr.Min,rr.Max,GetColorU32(held ? ImGuiCol_HeaderActive : ImGuiCol_Header));
+      else if (hovered)
+        dl->AddRectFilled(rr.Min,rr.Max,GetColorU32(ImGuiCol_HeaderHovered));
+      if (!leaf)
+        RenderTriangle(ImVec2(x,pos.y),IsOpen(r.node) ? ImGuiDir_Down : ImGuiDir_Right,0.70f);
+      dl->AddText(g->Font,g->FontSize,ImVec2(x + g->FontSize * 1.5f,pos.y),textcol,text);
+    }
+  }
+  if (toggled >= 0)
+    toggle(toggled);
+  EndChild();
+  return changed;
+}
+
+void Tree::setrows(){
+  visible.resize(0);
+  expand(-1,0,visible);
+  rowof.resize(nnodes);
+  memset(rowof.Data,0xff,nnodes * sizeof(int));
+  reindex(0);
+}
+
+void Tree::reindex(int i){
+  for (; i < visible.Size; i++)
+    rowof[visible[i].node] = i;
+}
+
+void Tree::toggle(int i){
+  const int node = visible[i].node, depth = visible[i].depth;
+  if (IsOpen(node)){
+    // remove the rows of the subtree
+    openbits[node >> 5] &= ~((ImU32) 1 << (node & 31));
+    int j = i + 1;
+    while (j < visible.Size && visible[j].depth > depth)
+      rowof[visible[j++].node] = -1;
+    memmove(visible.Data + i + 1,visible.Data + j,(visible.Size - j) * sizeof(Row));
+    visible.resize(visible.Size - (j - i - 1));
+    reindex(i + 1);
+  } else {
+    // insert the visible rows of the subtree
+    openbits[node >> 5] |= (ImU32) 1 << (node & 31);
+    ImVector<Row> sub;
+    expand(node,depth + 1,sub);
+    const int n = visible.Size;
+    visible.resize(n + sub.Size);
+    memmove(visible.Data + i + 1 + sub.Size,visible.Data + i + 1,(n - i - 1) * sizeof(Row));
+    memcpy(visible.Data + i + 1,sub.Data,sub.Size * sizeof(Row));
+    reindex(i + 1);
+  }
+}
+
+void Tree::expand(int node, int depth, ImVector<Row>& list) const{
+  // depth-first, with an explicit stack of (node, next child)
+  struct Frame{ int node, k, n;};
+  ImVector<Frame> stack;
+  Frame f = {node, 0, childcount(user_data,node)};
+  stack.push_back(f);
+  while (!stack.empty()){
+    Frame &top = stack.back();
+    if (top.k >= top.n){
+      stack.pop_back();
+      continue;
+    }
+    int c = child(user_data,top.node,top.k++);
+    Row r = {c, depth + stack.Size - 1};
+    list.push_back(r);
+    if (IsOpen(c)){
+      Frame fc = {c, 0, childcount(user_data,c)};
+      stack.push_back(fc);
+    }
+  }
+}
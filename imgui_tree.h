@@ -0,0 +1,127 @@
+// -*-c++-*-
+/*
+  Copyright (c) 2017 Alberto Otero de la Roza
+  <aoterodelaroza@gmail.com>, Robin Myhr <x@example.com>, Isaac
+  Visintainer <x@example.com>, Richard Greaves <x@example.com>, Ángel
+  Martín Pendás <angel@fluor.quimica.uniovi.es> and Víctor Luaña
+  <victor@fluor.quimica.uniovi.es>.
+
+  critic2 is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or (at
+  your option) any later version.
+
+  critic2 is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// A tree view for very large trees (critical point and bond graphs,
+// ...). A tree made of TreeNode calls submits every open node every
+// frame and looks up its open state in the window storage. Instead,
+// the Tree keeps the list of the visible rows (the nodes whose
+// ancestors are all open, in display order, with their depth) and
+// draws only the rows in view through a list clipper, so the cost of
+// a frame does not depend on the size of the tree.
+//
+// The tree stays with the caller. Its nodes are numbered from 0 to
+// nnodes-1 and read through three functions:
+//
+//   int childcount(void *user_data, int node);     // number of children
+//   int child(void *user_data, int node, int k);   // k-th child
+//   const char *label(void *user_data, int node, char *buf, int buf_size);
+//
+// The roots of the tree are the children of node -1. label returns
+// buf or a string owned by the caller. Then:
+//
+//   Tree t;
+//   t.SetData(childcount,child,label,graph,nnodes);
+//   ...
+//   t.Draw("##graph");
+//
+// The open state is one bit per node. Opening a node inserts the
+// visible part of its subtree after it in the list, and closing it
+// removes the rows below it with a larger depth, so neither walks the
+// rest of the tree. The row of each node is kept in an index, so
+// SetOpen and ScrollToNode do not search the visible rows. Nodes are
+// opened and closed by clicking the arrow or double-clicking the row,
+// and selected by clicking the row. For 10^6 nodes the open state
+// takes 125 KB, the row index 4 MB, and the list of visible rows 8
+// bytes per visible row. If the structure of the tree changes, call
+// Rebuild.
+
+#ifndef IMGUI_TREE_H
+#define IMGUI_TREE_H
+
+#include "imgui.h"
+
+namespace ImGui{
+
+  typedef int (*TreeChildCount)(void *user_data, int node);
+  typedef int (*TreeChild)(void *user_data, int node, int k);
+  typedef const char *(*TreeLabel)(void *user_data, int node, char *buf, int buf_size);
+
+  struct Tree{
+    static const int MaxLabel = 256; // longest label, in bytes
+
+    // A visible row
+    struct Row{
+      int node; // node shown in the row
+      int depth; // depth of the node (0 for the roots)
+    };
+
+    TreeChildCount childcount = nullptr; // number of children of a node
+    TreeChild child = nullptr; // children of a node
+    TreeLabel label = nullptr; // label of a node
+    void *user_data = nullptr; // passed to childcount, child and label
+    int nnodes = 0; // number of nodes
+    ImVector<ImU32> openbits = {}; // open state, one bit per node
+    ImVector<Row> visible = {}; // visible rows, in display order
+    ImVector<int> rowof = {}; // row of each node in visible, or -1
+    int selected = -1; // selected node, or -1
+    int scrollto = -1; // node requested by ScrollToNode
+
+    Tree(){};
+
+    // Set the tree, with nnodes nodes, all closed.
+    void SetData(TreeChildCount childcount, TreeChild child, TreeLabel label, void* user_data, int nnodes);
+    // Build the visible rows again, keeping the open state. Call when
+    // the structure of the tree changes; nnodes is the new number of
+    // nodes.
+    void Rebuild(int nnodes);
+    // Whether a node is open.
+    bool IsOpen(int node) const{ return (openbits[node >> 5] >> (node & 31)) & 1;}
+    // Open or close a node.
+    void SetOpen(int node, bool open);
+    // Open or close all the nodes.
+    void SetAllOpen(bool open);
+    // Number of visible rows.
+    int GetVisibleCount() const{ return visible.Size;}
+    // Scroll the view so that a node is shown in the next Draw (if
+    // it is visible).
+    void ScrollToNode(int node){ scrollto = node;}
+    // Draw the tree in a child window of the given size (see
+    // BeginChild for the meaning of size). Returns true if the
+    // selected node changed.
+    bool Draw(const char* str_id, const ImVec2& size = ImVec2(0,0));
+
+    // Internal: position of a node in the visible rows, or -1.
+    int find(int node) const{ return (node >= 0 && node < nnodes) ? rowof[node] : -1;}
+    // Internal: build the visible rows and the row index from scratch.
+    void setrows();
+    // Internal: update the row index for the rows from i on.
+    void reindex(int i);
+    // Internal: open or close the node in visible row i.
+    void toggle(int i);
+    // Internal: append the visible descendants of node to list,
+    // starting at the given depth.
+    void expand(int node, int depth, ImVector<Row>& list) const;
+  }; // struct Tree
+
+} // namespace ImGui
+
+#endif
@@ -29,6 +29,8 @@
 #include "imgui_widgets.h"
 #include "imgui.h"
 #include "imgui_internal.h"
+#include <atomic>
+#include <stdint.h>
 
 using namespace std;
 
@@ -56,6 +58,92 @@ static inline ImVec4 TransparentColor(ImGuiCol_ color){
   return col;
 }
 
+// Bounded lock-free queue with N slots (N must be a power of
+// two). Any number of threads can push, but only one thread can pop
+// (usually the GUI thread). push() returns false if the queue is
+// full and pop() returns false if it is empty. push(x,n) pushes n
+// elements in consecutive slots, so the elements pushed by other
+// threads do not end up between them, or none if there is not room
+// for all.
+template<typename T, int N>
+struct LockFreeQueue {
+  struct Cell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+  Cell cells[N];
+  alignas(64) std::atomic<size_t> head; // next position to push
+  alignas(64) std::atomic<size_t> tail; // next position to pop
+
+  LockFreeQueue(){
+    static_assert((N & (N-1)) == 0, "LockFreeQueue size must be a power of two");
+    for (int i = 0; i < N; i++)
+      cells[i].seq.store(i,std::memory_order_relaxed);
+    head.store(0,std::memory_order_relaxed);
+    tail.store(0,std::memory_order_relaxed);
+  }
+
+  bool push(const T& x){
+    Cell *c;
+    size_t pos = head.load(std::memory_order_relaxed);
+    for (;;){
+      c = &cells[pos & (N-1)];
+      intptr_t dif = (intptr_t) c->seq.load(std::memory_order_acquire) - (intptr_t) pos;
+      if (dif == 0){
+        if (head.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+          break;
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+    c->data = x;
+    c->seq.store(pos+1,std::memory_order_release);
+    return true;
+  }
+
+  bool push(const T* x, int n){
+    if (n <= 0 || n > N) return n == 0;
+    size_t pos = head.load(std::memory_order_relaxed);
+    for (;;){
+      // The slots are freed in order, so there is room for n
+      // elements if the last slot is free.
+      intptr_t dif = (intptr_t) cells[pos & (N-1)].seq.load(std::memory_order_acquire) - (intptr_t) pos;
+      if (dif == 0){
+        intptr_t difl = (intptr_t) cells[(pos+n-1) & (N-1)].seq.load(std::memory_order_acquire) - (intptr_t) (pos+n-1);
+        if (difl < 0)
+          return false;
+        if (difl == 0 && head.compare_exchange_weak(pos,pos+n,std::memory_order_relaxed))
+          break;
+        if (difl > 0)
+          pos = head.load(std::memory_order_relaxed);
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+    for (int i = 0; i < n; i++){
+      Cell *c = &cells[(pos+i) & (N-1)];
+      c->data = x[i];
+      c->seq.store(pos+i+1,std::memory_order_release);
+    }
+    return true;
+  }
+
+  bool pop(T* x){
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Cell *c = &cells[pos & (N-1)];
+    if ((intptr_t) c->seq.load(std::memory_order_acquire) - (intptr_t) (pos+1) < 0)
+      return false;
+    *x = c->data;
+    c->seq.store(pos+N,std::memory_order_release);
+    tail.store(pos+1,std::memory_order_relaxed);
+    return true;
+  }
+};
+
 // Colors for the widgets
 enum ImGuiColWidgets_ {
   ImGuiColWidgets_Slidingbar,